@@ -0,0 +1,289 @@
+/*
+  ==============================================================================
+
+    EnsembleChorus.cpp
+    Created: 23 Oct 2026 10:05:19am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "EnsembleChorus.h"
+
+void EnsembleChorus::prepare(double sampleRate)
+{
+    _sampleRate = sampleRate;
+    _ringSize = juce::nextPowerOfTwo(static_cast<int>(std::ceil(_maxDelaySeconds * sampleRate)) + _controlBlockSize);
+    _ringMask = _ringSize - 1;
+    _ring.assign(static_cast<size_t>(_ringSize) * 2, 0.0f);
+    
+    _appliedMix = -1.0f;
+    _wetGain.reset(0.0f);
+    reset();
+}
+
+void EnsembleChorus::reset()
+{
+    std::fill(_ring.begin(), _ring.end(), 0.0f);
+    _writePosition = 0;
+    _idleTracker.reset();
+    startTaps(_numTaps.load(std::memory_order_relaxed));
+}
+
+void EnsembleChorus::setMix(float mix)
+{
+    _mix.store(std::clamp(mix, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void EnsembleChorus::setRate(float hertz)
+{
+    _rate.store(std::max(0.0f, hertz), std::memory_order_relaxed);
+}
+
+void EnsembleChorus::setDepth(float depth)
+{
+    _depth.store(std::clamp(depth, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void EnsembleChorus::setNumTaps(int taps)
+{
+    _numTaps.store(std::clamp(taps, 1, maxTaps), std::memory_order_relaxed);
+}
+
+void EnsembleChorus::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    if (_ring.empty())
+        return;
+    
+    const auto mix = _mix.load(std::memory_order_relaxed);
+    if (mix != _appliedMix)
+    {
+        _wetGain.setTargetGain(mix, _mixRampSeconds, _sampleRate);
+        _appliedMix = mix;
+    }
+    
+    // The ring is only a few milliseconds long, so switching off simply clears it
+    if (_wetGain.isSilent())
+    {
+        if (!_idleTracker.isIdle())
+        {
+            reset();
+        }
+        
+        return;
+    }
+    
+    auto* left = buffer.getWritePointer(0);
+    auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : left;
+    
+    if (!_idleTracker.startBlock(IdleTracker::getPeak(buffer, 2, numSamples)))
+        return;
+    
+    // Tap count changes are picked up between blocks and ramped in over the following ones
+    const auto numTaps = _numTaps.load(std::memory_order_relaxed);
+    if (numTaps != _activeTaps)
+    {
+        changeTaps(numTaps);
+    }
+    
+    for (auto offset = 0; offset < numSamples; offset += _controlBlockSize)
+    {
+        const auto blockSize = std::min(_controlBlockSize, numSamples - offset);
+        
+        // Write the block first, every tap is at least a millisecond behind it
+        for (auto i = 0; i < blockSize; ++i)
+        {
+            const auto position = (_writePosition + i) & _ringMask;
+            const auto input = 0.5f * (left[offset + i] + right[offset + i]);
+            _ring[static_cast<size_t>(position)] = input;
+            _ring[static_cast<size_t>(position + _ringSize)] = input;
+        }
+        
+        juce::FloatVectorOperations::clear(_wet[0].data(), blockSize);
+        juce::FloatVectorOperations::clear(_wet[1].data(), blockSize);
+        const auto rampLength = std::min(blockSize, _tapRampSamples);
+        for (auto tap = 0; tap < maxTaps; ++tap)
+        {
+            if (isTapSilent(tap))
+                continue;
+            
+            renderTap(tap, getNextTapDelay(tap, blockSize), blockSize);
+            mixTap(tap, blockSize, rampLength);
+        }
+        
+        // Ramps end exactly on the new gains, which also leaves departed taps at silence
+        _tapRampSamples -= rampLength;
+        if (rampLength > 0 && _tapRampSamples == 0)
+        {
+            for (auto tap = 0; tap < maxTaps; ++tap)
+            {
+                _tapGains[static_cast<size_t>(tap)] = getTapGains(tap, _activeTaps);
+                _tapGainSteps[static_cast<size_t>(tap)] = {};
+            }
+        }
+        
+        _writePosition = (_writePosition + blockSize) & _ringMask;
+        
+        if (_wetGain.isRamping())
+        {
+            for (auto i = 0; i < blockSize; ++i)
+            {
+                const auto gain = _wetGain.getNextSample();
+                left[offset + i] += _wet[0][static_cast<size_t>(i)] * gain;
+                if (right != left)
+                {
+                    right[offset + i] += _wet[1][static_cast<size_t>(i)] * gain;
+                }
+            }
+        }
+        else
+        {
+            const auto gain = _wetGain.getNextSample();
+            juce::FloatVectorOperations::addWithMultiply(left + offset, _wet[0].data(), gain, blockSize);
+            if (right != left)
+            {
+                juce::FloatVectorOperations::addWithMultiply(right + offset, _wet[1].data(), gain, blockSize);
+            }
+        }
+    }
+    
+    // With no feedback, a ring's worth of silent input leaves nothing but zeros behind
+    _idleTracker.endBlock(numSamples, _ringSize);
+}
+
+bool EnsembleChorus::isIdle() const
+{
+    return _idleTracker.isIdle();
+}
+
+// Spreads the LFO phases evenly over the taps and moves every tap to its starting delay and gain
+void EnsembleChorus::startTaps(int numTaps)
+{
+    _activeTaps = numTaps;
+    _tapRampSamples = 0;
+    for (auto tap = 0; tap < maxTaps; ++tap)
+    {
+        const auto index = static_cast<size_t>(tap);
+        _chorusPhases[index] = static_cast<double>(tap) / static_cast<double>(numTaps);
+        _vibratoPhases[index] = std::fmod(static_cast<double>(tap) * 0.37, 1.0);
+        _tapDelays[index] = static_cast<float>(_baseDelaySeconds * _sampleRate);
+        _tapGains[index] = getTapGains(tap, numTaps);
+        _tapGainSteps[index] = {};
+    }
+}
+
+// Ramps every tap from its current gains to the ones for the new count. Sounding taps keep
+// their LFOs and delays, a tap joining from silence starts at its place in the new spread
+void EnsembleChorus::changeTaps(int numTaps)
+{
+    _activeTaps = numTaps;
+    _tapRampSamples = std::max(1, static_cast<int>(_tapRampSeconds * _sampleRate));
+    for (auto tap = 0; tap < maxTaps; ++tap)
+    {
+        const auto index = static_cast<size_t>(tap);
+        if (tap < numTaps && isTapSilent(tap))
+        {
+            restartTap(tap, numTaps);
+        }
+        
+        const auto targetGains = getTapGains(tap, numTaps);
+        for (size_t channel = 0; channel < 2; ++channel)
+        {
+            _tapGainSteps[index][channel] = (targetGains[channel] - _tapGains[index][channel]) / static_cast<float>(_tapRampSamples);
+        }
+    }
+}
+
+// Tap 0 always sounds and started at phase 0, so its phase is the time since the spread began
+void EnsembleChorus::restartTap(int tap, int numTaps)
+{
+    const auto index = static_cast<size_t>(tap);
+    _chorusPhases[index] = std::fmod(_chorusPhases[0] + static_cast<double>(tap) / static_cast<double>(numTaps), 1.0);
+    _vibratoPhases[index] = std::fmod(_vibratoPhases[0] + static_cast<double>(tap) * 0.37, 1.0);
+    _tapDelays[index] = getTapDelay(tap);
+}
+
+bool EnsembleChorus::isTapSilent(int tap) const
+{
+    const auto index = static_cast<size_t>(tap);
+    return _tapGains[index][0] == 0.0f && _tapGains[index][1] == 0.0f
+        && _tapGainSteps[index][0] == 0.0f && _tapGainSteps[index][1] == 0.0f;
+}
+
+// Equal-power pan with the taps spread evenly from left to right, scaled so the count doesn't change the level
+std::array<float, 2> EnsembleChorus::getTapGains(int tap, int numTaps) const
+{
+    if (tap >= numTaps)
+        return { 0.0f, 0.0f };
+    
+    const auto tapGain = 1.0f / std::sqrt(static_cast<float>(numTaps));
+    const auto pan = numTaps > 1 ? static_cast<float>(tap) / static_cast<float>(numTaps - 1) : 0.5f;
+    const auto angle = pan * juce::MathConstants<float>::halfPi;
+    return { std::cos(angle) * tapGain, std::sin(angle) * tapGain };
+}
+
+// The tap's delay at its current LFO phases
+float EnsembleChorus::getTapDelay(int tap) const
+{
+    const auto index = static_cast<size_t>(tap);
+    const auto depthSeconds = static_cast<double>(_depth.load(std::memory_order_relaxed)) * _maxDepthSeconds;
+    const auto chorus = std::sin(juce::MathConstants<double>::twoPi * _chorusPhases[index]);
+    const auto vibrato = std::sin(juce::MathConstants<double>::twoPi * _vibratoPhases[index]);
+    const auto delaySeconds = _baseDelaySeconds + depthSeconds * (chorus + _vibratoDepthRatio * vibrato);
+    
+    return static_cast<float>(std::max(0.001, delaySeconds) * _sampleRate);
+}
+
+// Advances the tap's LFOs by one control block and returns its delay at the end of it
+float EnsembleChorus::getNextTapDelay(int tap, int numSamples)
+{
+    const auto index = static_cast<size_t>(tap);
+    const auto rate = static_cast<double>(_rate.load(std::memory_order_relaxed));
+    const auto blockSeconds = numSamples / _sampleRate;
+    
+    _chorusPhases[index] = std::fmod(_chorusPhases[index] + rate * blockSeconds, 1.0);
+    _vibratoPhases[index] = std::fmod(_vibratoPhases[index] + rate * _vibratoRateRatio * blockSeconds, 1.0);
+    return getTapDelay(tap);
+}
+
+// Reads one tap into _tapSignal, gliding linearly from its last delay to endDelay
+void EnsembleChorus::renderTap(int tap, float endDelay, int numSamples)
+{
+    const auto index = static_cast<size_t>(tap);
+    const auto startDelay = _tapDelays[index];
+    const auto delayStep = (endDelay - startDelay) / static_cast<float>(numSamples);
+    const auto* ring = _ring.data();
+    
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        const auto delay = startDelay + delayStep * static_cast<float>(i + 1);
+        const auto position = static_cast<float>(((_writePosition + i) & _ringMask) + _ringSize) - delay;
+        const auto whole = static_cast<int>(position);
+        const auto fraction = position - static_cast<float>(whole);
+        _tapSignal[static_cast<size_t>(i)] = ring[whole] + fraction * (ring[whole + 1] - ring[whole]);
+    }
+    
+    _tapDelays[index] = endDelay;
+}
+
+// Adds _tapSignal to the wet buffers, ramping the tap's gains over the first rampLength samples
+void EnsembleChorus::mixTap(int tap, int numSamples, int rampLength)
+{
+    const auto index = static_cast<size_t>(tap);
+    for (size_t channel = 0; channel < 2; ++channel)
+    {
+        auto* wet = _wet[channel].data();
+        auto& gain = _tapGains[index][channel];
+        const auto step = _tapGainSteps[index][channel];
+        for (auto i = 0; i < rampLength; ++i)
+        {
+            wet[i] += _tapSignal[static_cast<size_t>(i)] * (gain + step * static_cast<float>(i + 1));
+        }
+        
+        gain += step * static_cast<float>(rampLength);
+        if (numSamples > rampLength)
+        {
+            juce::FloatVectorOperations::addWithMultiply(wet + rampLength, _tapSignal.data() + rampLength, gain, numSamples - rampLength);
+        }
+    }
+}
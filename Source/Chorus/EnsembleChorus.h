@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    EnsembleChorus.h
+    Created: 23 Oct 2026 10:05:19am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Gain/Gain.h"
+#include "../Utils/IdleTracker.h"
+
+// String-machine style ensemble for the summed bus. Up to six taps read one shared
+// delay line of the mono input. Each tap is modulated by a slow chorus LFO and a
+// faster vibrato, with the phases spread across the taps, and the taps are panned
+// across the stereo field. The LFOs run once per 32-sample control block, and the
+// delay is interpolated linearly between control points. The ring is stored twice
+// over, so tap reads never wrap and the inner loops have no branches. Changing the
+// number of taps fades taps in or out and slides the others to their new pans.
+class EnsembleChorus
+{
+public:
+    static constexpr int maxTaps = 6;
+    
+    EnsembleChorus() = default;
+    
+    void prepare(double sampleRate);
+    void reset();
+    
+    // Message thread
+    void setMix(float mix);
+    void setRate(float hertz);
+    void setDepth(float depth);
+    void setNumTaps(int taps);
+    
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+    bool isIdle() const;
+    
+private:
+    static constexpr int _controlBlockSize = 32;
+    static constexpr double _baseDelaySeconds = 0.012;
+    static constexpr double _maxDepthSeconds = 0.004;
+    static constexpr double _vibratoRateRatio = 11.0;  // Vibrato runs this much faster than the chorus LFO
+    static constexpr double _vibratoDepthRatio = 0.15; // and this much shallower
+    static constexpr double _maxDelaySeconds = 0.03;
+    static constexpr float _mixRampSeconds = 0.05f;
+    static constexpr double _tapRampSeconds = 0.05;
+    
+    // Mirrored ring: sample n is at n and n + _ringSize, so any read within the delay range is contiguous
+    std::vector<float> _ring;
+    int _ringSize = 0;
+    int _ringMask = 0;
+    int _writePosition = 0;
+    
+    std::array<double, maxTaps> _chorusPhases {};
+    std::array<double, maxTaps> _vibratoPhases {};
+    std::array<float, maxTaps> _tapDelays {}; // Samples, at the start of the next control block
+    std::array<std::array<float, 2>, maxTaps> _tapGains {}; // Left and right, at the start of the next control block
+    std::array<std::array<float, 2>, maxTaps> _tapGainSteps {}; // Per sample while the taps ramp
+    int _tapRampSamples = 0; // Left in the current ramp
+    alignas(64) std::array<float, _controlBlockSize> _tapSignal {};
+    alignas(64) std::array<std::array<float, _controlBlockSize>, 2> _wet {};
+    
+    double _sampleRate = 44100.0;
+    Gain _wetGain;
+    IdleTracker _idleTracker;
+    int _activeTaps = maxTaps;
+    
+    std::atomic<float> _mix = 0.0f;
+    std::atomic<float> _rate = 0.6f;
+    std::atomic<float> _depth = 0.5f;
+    std::atomic<int> _numTaps = maxTaps;
+    float _appliedMix = -1.0f;
+    
+    // Helpers
+    void startTaps(int numTaps);
+    void changeTaps(int numTaps);
+    void restartTap(int tap, int numTaps);
+    bool isTapSilent(int tap) const;
+    std::array<float, 2> getTapGains(int tap, int numTaps) const;
+    float getTapDelay(int tap) const;
+    float getNextTapDelay(int tap, int numSamples);
+    void renderTap(int tap, float endDelay, int numSamples);
+    void mixTap(int tap, int numSamples, int rampLength);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EnsembleChorus)
+};
@@ -1,50 +1,157 @@
-/*
-  ==============================================================================
-
-    ParameterIds.h
-    Created: 6 Jul 2025 5:08:57pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#pragma once
-namespace ParameterIds
-{
-    inline constexpr const char* OscillatorATypeId       = "oscillatorAType";
-    inline constexpr const char* OscillatorBTypeId       = "oscillatorBType";
-    inline constexpr const char* OscillatorSubTypeId     = "oscillatorSubType";
-    inline constexpr const char* OscillatorAGainId       = "oscillatorAGain";
-    inline constexpr const char* OscillatorBGainId       = "oscillatorBGain";
-    inline constexpr const char* OscillatorSubGainId     = "oscillatorSubGain";
-
-    inline constexpr const char* AmplitudeEnvelopeAttackId  = "amplitudeEnvelopeAttack";
-    inline constexpr const char* AmplitudeEnvelopeDecayId   = "amplitudeEnvelopeDecay";
-    inline constexpr const char* AmplitudeEnvelopeSustainId = "amplitudeEnvelopeSustain";
-    inline constexpr const char* AmplitudeEnvelopeReleaseId = "amplitudeEnvelopeRelease";
-
-    inline constexpr const char* ModulationEnvelopeAttackId  = "modulationEnvelopeAttack";
-    inline constexpr const char* ModulationEnvelopeDecayId   = "modulationEnvelopeDecay";
-    inline constexpr const char* ModulationEnvelopeSustainId = "modulationEnvelopeSustain";
-    inline constexpr const char* ModulationEnvelopeReleaseId = "modulationEnvelopeRelease";
-
-    inline constexpr const char* MasterGainId = "masterGain";
-    
-    inline constexpr const char* parameterIds[] = {
-        OscillatorATypeId,
-        OscillatorBTypeId,
-        OscillatorSubTypeId,
-        OscillatorAGainId,
-        OscillatorBGainId,
-        OscillatorSubGainId,
-        AmplitudeEnvelopeAttackId,
-        AmplitudeEnvelopeDecayId,
-        AmplitudeEnvelopeSustainId,
-        AmplitudeEnvelopeReleaseId,
-        ModulationEnvelopeAttackId,
-        ModulationEnvelopeDecayId,
-        ModulationEnvelopeSustainId,
-        ModulationEnvelopeReleaseId,
-        MasterGainId
-    };
-}
+/*
+  ==============================================================================
+
+    ParameterIds.h
+    Created: 6 Jul 2025 5:08:57pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+namespace ParameterIds
+{
+    inline constexpr const char* OscillatorATypeId       = "oscillatorAType";
+    inline constexpr const char* OscillatorBTypeId       = "oscillatorBType";
+    inline constexpr const char* OscillatorSubTypeId     = "oscillatorSubType";
+    inline constexpr const char* OscillatorAGainId       = "oscillatorAGain";
+    inline constexpr const char* OscillatorBGainId       = "oscillatorBGain";
+    inline constexpr const char* OscillatorSubGainId     = "oscillatorSubGain";
+
+    inline constexpr const char* AmplitudeEnvelopeAttackId  = "amplitudeEnvelopeAttack";
+    inline constexpr const char* AmplitudeEnvelopeDecayId   = "amplitudeEnvelopeDecay";
+    inline constexpr const char* AmplitudeEnvelopeSustainId = "amplitudeEnvelopeSustain";
+    inline constexpr const char* AmplitudeEnvelopeReleaseId = "amplitudeEnvelopeRelease";
+
+    inline constexpr const char* ModulationEnvelopeAttackId  = "modulationEnvelopeAttack";
+    inline constexpr const char* ModulationEnvelopeDecayId   = "modulationEnvelopeDecay";
+    inline constexpr const char* ModulationEnvelopeSustainId = "modulationEnvelopeSustain";
+    inline constexpr const char* ModulationEnvelopeReleaseId = "modulationEnvelopeRelease";
+
+    inline constexpr const char* MasterGainId = "masterGain";
+    
+    inline constexpr const char* PlayModeId     = "playMode";
+    inline constexpr const char* NotePriorityId = "notePriority";
+    inline constexpr const char* LegatoId       = "legato";
+    inline constexpr const char* GlideTimeId    = "glideTime";
+    inline constexpr const char* GlideModeId    = "glideMode";
+    
+    inline constexpr const char* MpeEnabledId        = "mpeEnabled";
+    inline constexpr const char* MpePitchBendRangeId = "mpePitchBendRange";
+    
+    inline constexpr const char* MultiTimbralId   = "multiTimbral";
+    inline constexpr const char* EditPartId       = "editPart";
+    inline constexpr const char* PartPolyphonyId  = "partPolyphony";
+    inline constexpr const char* VoiceBudgetId    = "voiceBudget";
+    
+    inline constexpr const char* OversamplingId        = "oversampling";
+    inline constexpr const char* OfflineOversamplingId = "offlineOversampling";
+    
+    inline constexpr const char* LimiterLookaheadId = "limiterLookahead";
+    
+    inline constexpr const char* ReverbMixId     = "reverbMix";
+    inline constexpr const char* ReverbDecayId   = "reverbDecay";
+    inline constexpr const char* ReverbDampingId = "reverbDamping";
+    
+    inline constexpr const char* DelayMixId      = "delayMix";
+    inline constexpr const char* DelaySyncId     = "delaySync";
+    inline constexpr const char* DelayDivisionId = "delayDivision";
+    inline constexpr const char* DelayTimeId     = "delayTime";
+    inline constexpr const char* DelayFeedbackId = "delayFeedback";
+    inline constexpr const char* DelayToneId     = "delayTone";
+    inline constexpr const char* DelayPingPongId = "delayPingPong";
+    
+    inline constexpr const char* ChorusMixId   = "chorusMix";
+    inline constexpr const char* ChorusRateId  = "chorusRate";
+    inline constexpr const char* ChorusDepthId = "chorusDepth";
+    inline constexpr const char* ChorusTapsId  = "chorusTaps";
+    
+    inline constexpr const char* VoiceDriveId      = "voiceDrive";
+    inline constexpr const char* VoiceDriveShapeId = "voiceDriveShape";
+    inline constexpr const char* BusDriveId        = "busDrive";
+    inline constexpr const char* BusDriveShapeId   = "busDriveShape";
+    
+    inline constexpr const char* ConvolutionEnabledId = "convolutionEnabled";
+    inline constexpr const char* ConvolutionMixId     = "convolutionMix";
+    
+    inline constexpr const char* parameterIds[] = {
+        OscillatorATypeId,
+        OscillatorBTypeId,
+        OscillatorSubTypeId,
+        OscillatorAGainId,
+        OscillatorBGainId,
+        OscillatorSubGainId,
+        AmplitudeEnvelopeAttackId,
+        AmplitudeEnvelopeDecayId,
+        AmplitudeEnvelopeSustainId,
+        AmplitudeEnvelopeReleaseId,
+        ModulationEnvelopeAttackId,
+        ModulationEnvelopeDecayId,
+        ModulationEnvelopeSustainId,
+        ModulationEnvelopeReleaseId,
+        MasterGainId,
+        PlayModeId,
+        NotePriorityId,
+        LegatoId,
+        GlideTimeId,
+        GlideModeId,
+        MpeEnabledId,
+        MpePitchBendRangeId,
+        MultiTimbralId,
+        EditPartId,
+        PartPolyphonyId,
+        VoiceBudgetId,
+        OversamplingId,
+        OfflineOversamplingId,
+        LimiterLookaheadId,
+        ReverbMixId,
+        ReverbDecayId,
+        ReverbDampingId,
+        DelayMixId,
+        DelaySyncId,
+        DelayDivisionId,
+        DelayTimeId,
+        DelayFeedbackId,
+        DelayToneId,
+        DelayPingPongId,
+        ChorusMixId,
+        ChorusRateId,
+        ChorusDepthId,
+        ChorusTapsId,
+        VoiceDriveId,
+        VoiceDriveShapeId,
+        BusDriveId,
+        BusDriveShapeId,
+        ConvolutionEnabledId,
+        ConvolutionMixId
+    };
+    
+    // Part selection, the voice budget, oversampling and the bus effects apply to the whole
+    // instance, every other parameter is kept per multi-timbral part
+    inline constexpr const char* globalParameterIds[] = {
+        MultiTimbralId,
+        EditPartId,
+        VoiceBudgetId,
+        OversamplingId,
+        OfflineOversamplingId,
+        LimiterLookaheadId,
+        ReverbMixId,
+        ReverbDecayId,
+        ReverbDampingId,
+        DelayMixId,
+        DelaySyncId,
+        DelayDivisionId,
+        DelayTimeId,
+        DelayFeedbackId,
+        DelayToneId,
+        DelayPingPongId,
+        ChorusMixId,
+        ChorusRateId,
+        ChorusDepthId,
+        ChorusTapsId,
+        BusDriveId,
+        BusDriveShapeId,
+        ConvolutionEnabledId,
+        ConvolutionMixId
+    };
+}
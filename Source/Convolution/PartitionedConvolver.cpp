@@ -0,0 +1,726 @@
+/*
+  ==============================================================================
+    
+    PartitionedConvolver.cpp
+    Created: 24 Oct 2026 11:20:43am
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#include "PartitionedConvolver.h"
+
+namespace
+{
+    // One uniformly partitioned overlap-save convolution. Spectra are kept split into real and
+    // imaginary arrays so the multiply-accumulate loops vectorise.
+    struct UniformStage
+    {
+        void prepare(const juce::AudioBuffer<float>& impulse, int start, int length, int blockSizeToUse, int numChannels)
+        {
+            blockSize = blockSizeToUse;
+            fftSize = blockSize * 2;
+            numBins = blockSize + 1;
+            numPartitions = (length + blockSize - 1) / blockSize;
+            numFilterChannels = impulse.getNumChannels();
+            
+            auto order = 0;
+            while ((1 << order) < fftSize)
+            {
+                ++order;
+            }
+            
+            fft = std::make_unique<juce::dsp::FFT>(order);
+            fftBuffer.assign(static_cast<size_t>(fftSize * 2), 0.0f);
+            accumulatorReal.assign(static_cast<size_t>(numBins), 0.0f);
+            accumulatorImaginary.assign(static_cast<size_t>(numBins), 0.0f);
+            
+            const auto spectrumSize = static_cast<size_t>(numPartitions * numBins);
+            filterReal.assign(spectrumSize * static_cast<size_t>(numFilterChannels), 0.0f);
+            filterImaginary.assign(spectrumSize * static_cast<size_t>(numFilterChannels), 0.0f);
+            for (auto channel = 0; channel < numFilterChannels; ++channel)
+            {
+                for (auto partition = 0; partition < numPartitions; ++partition)
+                {
+                    // Each partition sits in the first half of the frame, zero padded
+                    const auto partitionStart = start + partition * blockSize;
+                    const auto partitionLength = std::min(blockSize, start + length - partitionStart);
+                    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
+                    juce::FloatVectorOperations::copy(fftBuffer.data(), impulse.getReadPointer(channel, partitionStart), partitionLength);
+                    fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+                    
+                    const auto offset = static_cast<size_t>(channel * numPartitions + partition) * static_cast<size_t>(numBins);
+                    splitSpectrum(filterReal.data() + offset, filterImaginary.data() + offset);
+                }
+            }
+            
+            frames.resize(static_cast<size_t>(numChannels));
+            historyReal.resize(static_cast<size_t>(numChannels));
+            historyImaginary.resize(static_cast<size_t>(numChannels));
+            historyPositions.assign(static_cast<size_t>(numChannels), 0);
+            for (auto channel = 0; channel < numChannels; ++channel)
+            {
+                frames[static_cast<size_t>(channel)].assign(static_cast<size_t>(fftSize), 0.0f);
+                historyReal[static_cast<size_t>(channel)].assign(spectrumSize, 0.0f);
+                historyImaginary[static_cast<size_t>(channel)].assign(spectrumSize, 0.0f);
+            }
+        }
+        
+        void clear()
+        {
+            for (size_t channel = 0; channel < frames.size(); ++channel)
+            {
+                std::fill(frames[channel].begin(), frames[channel].end(), 0.0f);
+                std::fill(historyReal[channel].begin(), historyReal[channel].end(), 0.0f);
+                std::fill(historyImaginary[channel].begin(), historyImaginary[channel].end(), 0.0f);
+                historyPositions[channel] = 0;
+            }
+        }
+        
+        // Takes one block of input and writes the matching block of output
+        void process(int channel, int filterChannel, const float* input, float* output)
+        {
+            auto& frame = frames[static_cast<size_t>(channel)];
+            std::copy(frame.begin() + blockSize, frame.end(), frame.begin());
+            juce::FloatVectorOperations::copy(frame.data() + blockSize, input, blockSize);
+            
+            juce::FloatVectorOperations::copy(fftBuffer.data(), frame.data(), fftSize);
+            fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+            
+            auto& position = historyPositions[static_cast<size_t>(channel)];
+            auto* historyRealData = historyReal[static_cast<size_t>(channel)].data();
+            auto* historyImaginaryData = historyImaginary[static_cast<size_t>(channel)].data();
+            splitSpectrum(historyRealData + position * numBins, historyImaginaryData + position * numBins);
+            
+            // Newest input meets the first partition, older inputs the later ones
+            std::fill(accumulatorReal.begin(), accumulatorReal.end(), 0.0f);
+            std::fill(accumulatorImaginary.begin(), accumulatorImaginary.end(), 0.0f);
+            auto* accumulatedReal = accumulatorReal.data();
+            auto* accumulatedImaginary = accumulatorImaginary.data();
+            const auto filterOffset = static_cast<size_t>(filterChannel * numPartitions) * static_cast<size_t>(numBins);
+            for (auto partition = 0; partition < numPartitions; ++partition)
+            {
+                const auto slot = (position - partition + numPartitions) % numPartitions;
+                const auto* inputReal = historyRealData + slot * numBins;
+                const auto* inputImaginary = historyImaginaryData + slot * numBins;
+                const auto* partitionReal = filterReal.data() + filterOffset + static_cast<size_t>(partition * numBins);
+                const auto* partitionImaginary = filterImaginary.data() + filterOffset + static_cast<size_t>(partition * numBins);
+                for (auto bin = 0; bin < numBins; ++bin)
+                {
+                    accumulatedReal[bin] += inputReal[bin] * partitionReal[bin] - inputImaginary[bin] * partitionImaginary[bin];
+                    accumulatedImaginary[bin] += inputReal[bin] * partitionImaginary[bin] + inputImaginary[bin] * partitionReal[bin];
+                }
+            }
+            
+            position = (position + 1) % numPartitions;
+            
+            for (auto bin = 0; bin < numBins; ++bin)
+            {
+                fftBuffer[static_cast<size_t>(bin * 2)] = accumulatedReal[bin];
+                fftBuffer[static_cast<size_t>(bin * 2 + 1)] = accumulatedImaginary[bin];
+            }
+            
+            // The first half of the frame wraps around, only the second half is the linear convolution
+            fft->performRealOnlyInverseTransform(fftBuffer.data());
+            juce::FloatVectorOperations::copy(output, fftBuffer.data() + blockSize, blockSize);
+        }
+        
+        void splitSpectrum(float* real, float* imaginary) const
+        {
+            for (auto bin = 0; bin < numBins; ++bin)
+            {
+                real[bin] = fftBuffer[static_cast<size_t>(bin * 2)];
+                imaginary[bin] = fftBuffer[static_cast<size_t>(bin * 2 + 1)];
+            }
+        }
+        
+        int blockSize = 0;
+        int fftSize = 0;
+        int numBins = 0;
+        int numPartitions = 0;
+        int numFilterChannels = 0;
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::vector<float> fftBuffer;
+        std::vector<float> accumulatorReal;
+        std::vector<float> accumulatorImaginary;
+        std::vector<float> filterReal;
+        std::vector<float> filterImaginary;
+        std::vector<std::vector<float>> frames;
+        std::vector<std::vector<float>> historyReal;
+        std::vector<std::vector<float>> historyImaginary;
+        std::vector<int> historyPositions;
+    };
+}
+
+// A loaded response along with all the convolution state that belongs to it. An empty
+// kernel stands for no response at all.
+struct PartitionedConvolver::Kernel
+{
+    static constexpr int numTailSlots = 4;
+    
+    Kernel() = default;
+    
+    Kernel(const juce::AudioBuffer<float>& impulse, int impulseLength, double sampleRateToUse)
+        : length(impulseLength)
+        , numFilterChannels(impulse.getNumChannels())
+        , sampleRate(sampleRateToUse)
+    {
+        head.prepare(impulse, 0, std::min(length, _headLength), headBlockSize, _maxChannels);
+        if (length > _headLength)
+        {
+            tail.prepare(impulse, _headLength, length - _headLength, tailBlockSize, _maxChannels);
+            for (auto& slot : tailInput)
+            {
+                for (auto& channel : slot)
+                {
+                    channel.assign(static_cast<size_t>(tailBlockSize), 0.0f);
+                }
+            }
+            
+            for (auto& slot : tailOutput)
+            {
+                for (auto& channel : slot)
+                {
+                    channel.assign(static_cast<size_t>(tailBlockSize), 0.0f);
+                }
+            }
+            
+            for (auto& channel : workerInput)
+            {
+                channel.assign(static_cast<size_t>(tailBlockSize), 0.0f);
+            }
+        }
+        
+        for (auto& ready : tailReady)
+        {
+            ready.store(-1, std::memory_order_relaxed);
+        }
+        
+        clearHead();
+    }
+    
+    bool isEmpty() const
+    {
+        return length == 0;
+    }
+    
+    bool hasTail() const
+    {
+        return tail.numPartitions > 0;
+    }
+    
+    int getFilterChannel(int channel) const
+    {
+        return std::min(channel, numFilterChannels - 1);
+    }
+    
+    size_t getTailSlot(int64_t block) const
+    {
+        return static_cast<size_t>(block % numTailSlots);
+    }
+    
+    void clearHead()
+    {
+        head.clear();
+        for (auto channel = 0; channel < _maxChannels; ++channel)
+        {
+            headInput[static_cast<size_t>(channel)].fill(0.0f);
+            headOutput[static_cast<size_t>(channel)].fill(0.0f);
+        }
+    }
+    
+    // Audio thread. The worker clears the tail itself, and block numbers carry on past
+    // every one used so far so nothing it still has in hand passes for a new block
+    void restartTail(int64_t inputPosition)
+    {
+        blockOffset += inputPosition / tailBlockSize + 1;
+        firstBlock.store(blockOffset, std::memory_order_relaxed);
+        resetRequested.store(true, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    
+    // Audio thread, once block's input is complete
+    void postTailBlock(int64_t block, int numChannels)
+    {
+        postedChannels.store(numChannels, std::memory_order_relaxed);
+        postedBlock.store(block, std::memory_order_release);
+        
+        // Keeps the next block's input from landing before the post, see runTailBlock
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    
+    // Worker thread, catches up on every block posted so far
+    void runTailJobs()
+    {
+        for (;;)
+        {
+            const auto posted = postedBlock.load(std::memory_order_acquire);
+            if (resetRequested.exchange(false, std::memory_order_acquire))
+            {
+                tail.clear();
+                workerBlock = firstBlock.load(std::memory_order_relaxed) - 1;
+                continue;
+            }
+            
+            if (workerBlock >= posted)
+                return;
+            
+            runTailBlock(++workerBlock);
+        }
+    }
+    
+    void runTailBlock(int64_t block)
+    {
+        const auto slot = getTailSlot(block);
+        const auto numChannels = postedChannels.load(std::memory_order_relaxed);
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            const auto& input = tailInput[slot][static_cast<size_t>(channel)];
+            std::copy(input.begin(), input.end(), workerInput[static_cast<size_t>(channel)].begin());
+        }
+        
+        // The audio thread refills the slot once three more blocks are posted, or straight
+        // after a restart. A copy that may have overlapped that goes in as silence
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto isOverwritten = resetRequested.load(std::memory_order_relaxed) || postedBlock.load(std::memory_order_relaxed) >= block + numTailSlots - 1;
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            auto& input = workerInput[static_cast<size_t>(channel)];
+            if (isOverwritten)
+            {
+                std::fill(input.begin(), input.end(), 0.0f);
+            }
+            
+            tail.process(channel, getFilterChannel(channel), input.data(), tailOutput[slot][static_cast<size_t>(channel)].data());
+        }
+        
+        tailReady[slot].store(block, std::memory_order_release);
+    }
+    
+    int length = 0;
+    int numFilterChannels = 0;
+    double sampleRate = 0.0;
+    UniformStage head;
+    UniformStage tail;
+    std::array<std::array<float, headBlockSize>, _maxChannels> headInput {};
+    std::array<std::array<float, headBlockSize>, _maxChannels> headOutput {};
+    
+    // Input block j is written to slot j % 4 and its output is read from slot j % 4 three blocks later
+    std::array<std::array<std::vector<float>, _maxChannels>, numTailSlots> tailInput;
+    std::array<std::array<std::vector<float>, _maxChannels>, numTailSlots> tailOutput;
+    std::array<std::atomic<int64_t>, numTailSlots> tailReady;
+    std::atomic<int64_t> postedBlock = -1;
+    std::atomic<int64_t> firstBlock = 0;
+    std::atomic<int> postedChannels = 0;
+    std::atomic<bool> resetRequested = false;
+    int64_t blockOffset = 0; // Audio thread, tail block numbers are the timeline's block plus this
+    
+    // Worker thread
+    std::array<std::vector<float>, _maxChannels> workerInput;
+    int64_t workerBlock = -1;
+};
+
+PartitionedConvolver::PartitionedConvolver()
+    : juce::Thread("Convolution Tail")
+{
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+    _loader.removeAllJobs(true, 2000);
+    stopThread(1000);
+}
+
+void PartitionedConvolver::prepare(double sampleRate)
+{
+    const auto rateChanged = sampleRate != _sampleRate;
+    _sampleRate = sampleRate;
+    _appliedMix = -1.0f;
+    
+    if (!isThreadRunning())
+    {
+        startRealtimeThread(juce::Thread::RealtimeOptions {}.withApproximateAudioProcessingTime(tailBlockSize, sampleRate));
+    }
+    
+    // Responses are built for one rate, so a loaded file is read again at the new one
+    if (rateChanged)
+    {
+        const juce::ScopedLock lock(_fileLock);
+        if (_file.existsAsFile())
+        {
+            requestLoad(_file, sampleRate);
+        }
+    }
+    
+    reset();
+}
+
+void PartitionedConvolver::reset()
+{
+    clearHistory();
+}
+
+bool PartitionedConvolver::loadImpulseResponse(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return false;
+    
+    const juce::ScopedLock lock(_fileLock);
+    _file = file;
+    if (_sampleRate > 0.0)
+    {
+        requestLoad(file, _sampleRate);
+    }
+    
+    return true;
+}
+
+void PartitionedConvolver::clearImpulseResponse()
+{
+    {
+        const juce::ScopedLock lock(_fileLock);
+        _file = juce::File();
+    }
+    
+    // Queued behind any load still running, so a slow file can't come back after the clear
+    _loader.addJob([this]
+    {
+        _kernels.publish(std::make_unique<Kernel>());
+    });
+}
+
+void PartitionedConvolver::setEnabled(bool enabled)
+{
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void PartitionedConvolver::setMix(float mix)
+{
+    _mix.store(std::clamp(mix, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+int PartitionedConvolver::getLatencySamples() const
+{
+    return _enabled.load(std::memory_order_relaxed) ? headBlockSize : 0;
+}
+
+void PartitionedConvolver::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    swapPendingKernel();
+    
+    const auto enabled = _enabled.load(std::memory_order_relaxed);
+    if (enabled != _wasEnabled)
+    {
+        // Whatever was left from before it was switched off is stale by now
+        _wasEnabled = enabled;
+        if (enabled)
+        {
+            clearHistory();
+        }
+    }
+    
+    if (!enabled)
+        return;
+    
+    updateMix();
+    
+    // Everything still in flight is silence, so the timeline can stop until the next sound
+    const auto numChannels = std::min(buffer.getNumChannels(), _maxChannels);
+    if (!_idleTracker.startBlock(IdleTracker::getPeak(buffer, numChannels, numSamples)))
+        return;
+    
+    auto* kernel = _kernel != nullptr && !_kernel->isEmpty() ? _kernel.get() : nullptr;
+    for (auto offset = 0; offset < numSamples;)
+    {
+        // Chunks never cross a head block, and so never cross a tail block either
+        const auto position = static_cast<int>(_inputPosition % headBlockSize);
+        const auto count = std::min(numSamples - offset, headBlockSize - position);
+        
+        if (kernel != nullptr && kernel->hasTail())
+        {
+            updateTailOutput(*kernel);
+        }
+        
+        const auto isRamping = _wetGain.isRamping();
+        if (isRamping)
+        {
+            for (auto i = 0; i < count; ++i)
+            {
+                _mixGains[static_cast<size_t>(i)] = _wetGain.getNextSample();
+            }
+        }
+        
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            mixChannel(buffer.getWritePointer(channel, offset), channel, position, count, kernel, isRamping);
+        }
+        
+        _inputPosition += count;
+        offset += count;
+        if (kernel != nullptr && position + count == headBlockSize)
+        {
+            finishHeadBlock(*kernel, numChannels);
+        }
+    }
+    
+    const auto idleLength = kernel != nullptr ? kernel->length + 4 * tailBlockSize : headBlockSize;
+    _idleTracker.endBlock(numSamples, idleLength);
+}
+
+bool PartitionedConvolver::isIdle() const
+{
+    return !_wasEnabled || _idleTracker.isIdle();
+}
+
+double PartitionedConvolver::getTailLengthSeconds() const
+{
+    return _enabled.load(std::memory_order_relaxed) ? _impulseSeconds.load(std::memory_order_relaxed) : 0.0;
+}
+
+int PartitionedConvolver::getNumTailMisses() const
+{
+    return _numTailMisses.load(std::memory_order_relaxed);
+}
+
+void PartitionedConvolver::requestLoad(const juce::File& file, double sampleRate)
+{
+    _loader.addJob([this, file, sampleRate]
+    {
+        if (auto kernel = createKernel(file, sampleRate))
+        {
+            _kernels.publish(std::move(kernel));
+        }
+    });
+}
+
+std::unique_ptr<PartitionedConvolver::Kernel> PartitionedConvolver::createKernel(const juce::File& file, double sampleRate)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || sampleRate <= 0.0)
+        return nullptr;
+    
+    const auto numChannels = std::min(static_cast<int>(reader->numChannels), _maxChannels);
+    const auto fileLength = static_cast<int>(std::min(reader->lengthInSamples, static_cast<juce::int64>(_maxImpulseSeconds * reader->sampleRate)));
+    if (numChannels == 0 || fileLength == 0)
+        return nullptr;
+    
+    // A few zeros past the end give the interpolator something to read on the last samples
+    constexpr auto padding = 8;
+    juce::AudioBuffer<float> source(numChannels, fileLength + padding);
+    source.clear();
+    reader->read(&source, 0, fileLength, 0, true, numChannels > 1);
+    
+    // Played at any other rate the response would be stretched, so it's converted here once
+    const auto ratio = reader->sampleRate / sampleRate;
+    auto length = fileLength;
+    juce::AudioBuffer<float> impulse;
+    if (ratio == 1.0)
+    {
+        impulse.makeCopyOf(source);
+    }
+    else
+    {
+        length = std::max(1, static_cast<int>(fileLength / ratio));
+        impulse.setSize(numChannels, length);
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            juce::LagrangeInterpolator interpolator;
+            interpolator.process(ratio, source.getReadPointer(channel), impulse.getWritePointer(channel), length);
+        }
+    }
+    
+    // A long fade into the noise floor only costs partitions
+    const auto peak = impulse.getMagnitude(0, length);
+    if (peak <= 0.0f)
+        return nullptr;
+    
+    const auto threshold = peak * _trimThreshold;
+    auto isQuiet = [&impulse, numChannels, threshold](int sample)
+    {
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            if (std::abs(impulse.getSample(channel, sample)) >= threshold)
+                return false;
+        }
+        
+        return true;
+    };
+    
+    while (length > 1 && isQuiet(length - 1))
+    {
+        --length;
+    }
+    
+    // Unit energy keeps loudness about the same from one response to the next, the loudest channel sets the gain
+    auto energy = 0.0;
+    for (auto channel = 0; channel < numChannels; ++channel)
+    {
+        auto channelEnergy = 0.0;
+        const auto* samples = impulse.getReadPointer(channel);
+        for (auto i = 0; i < length; ++i)
+        {
+            channelEnergy += static_cast<double>(samples[i]) * samples[i];
+        }
+        
+        energy = std::max(energy, channelEnergy);
+    }
+    
+    impulse.applyGain(0, length, static_cast<float>(1.0 / std::sqrt(energy)));
+    return std::make_unique<Kernel>(impulse, length, sampleRate);
+}
+
+void PartitionedConvolver::swapPendingKernel()
+{
+    auto* kernel = _kernels.takePending();
+    if (kernel == nullptr)
+        return;
+    
+    // The worker is pointed at the new kernel before the old one is retired, so it never runs a freed one
+    _workerKernel.store(kernel, std::memory_order_release);
+    _kernels.retire(_kernel.release());
+    _kernel.reset(kernel);
+    _impulseSeconds.store(kernel->isEmpty() ? 0.0 : kernel->length / kernel->sampleRate, std::memory_order_relaxed);
+    
+    // A new kernel starts out clear, only the timeline needs to start over
+    resetTimeline();
+}
+
+void PartitionedConvolver::updateMix()
+{
+    const auto mix = _mix.load(std::memory_order_relaxed);
+    if (mix == _appliedMix)
+        return;
+    
+    if (_appliedMix < 0.0f)
+    {
+        _wetGain.reset(mix);
+    }
+    else
+    {
+        _wetGain.setTargetGain(mix, _mixRampSeconds, _sampleRate);
+    }
+    
+    _appliedMix = mix;
+}
+
+void PartitionedConvolver::mixChannel(float* samples, int channel, int position, int count, Kernel* kernel, bool isRamping)
+{
+    auto* dry = _dryDelay[static_cast<size_t>(channel)].data() + position;
+    juce::FloatVectorOperations::copy(_input.data(), samples, count);
+    if (kernel == nullptr)
+    {
+        juce::FloatVectorOperations::copy(samples, dry, count);
+        juce::FloatVectorOperations::copy(dry, _input.data(), count);
+        return;
+    }
+    
+    juce::FloatVectorOperations::copy(kernel->headInput[static_cast<size_t>(channel)].data() + position, _input.data(), count);
+    juce::FloatVectorOperations::copy(_wet.data(), kernel->headOutput[static_cast<size_t>(channel)].data() + position, count);
+    if (kernel->hasTail())
+    {
+        const auto inputSlot = kernel->getTailSlot(kernel->blockOffset + _inputPosition / tailBlockSize);
+        const auto inputOffset = static_cast<size_t>(_inputPosition % tailBlockSize);
+        juce::FloatVectorOperations::copy(kernel->tailInput[inputSlot][static_cast<size_t>(channel)].data() + inputOffset, _input.data(), count);
+        
+        if (_isTailReady)
+        {
+            const auto outputOffset = (_inputPosition - headBlockSize) % tailBlockSize;
+            juce::FloatVectorOperations::add(_wet.data(), kernel->tailOutput[kernel->getTailSlot(_heardTailBlock)][static_cast<size_t>(channel)].data() + outputOffset, count);
+        }
+    }
+    
+    if (isRamping)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            const auto gain = _mixGains[static_cast<size_t>(i)];
+            samples[i] = dry[i] * (1.0f - gain) + _wet[static_cast<size_t>(i)] * gain;
+        }
+    }
+    else
+    {
+        const auto gain = _wetGain.getTargetGain();
+        juce::FloatVectorOperations::copyWithMultiply(samples, dry, 1.0f - gain, count);
+        juce::FloatVectorOperations::addWithMultiply(samples, _wet.data(), gain, count);
+    }
+    
+    juce::FloatVectorOperations::copy(dry, _input.data(), count);
+}
+
+// Decided once per tail block, so a block the worker finishes late is left out whole rather than cut in
+void PartitionedConvolver::updateTailOutput(Kernel& kernel)
+{
+    // The output is a head block behind the input, and tail block j starts at input block j + 3
+    const auto outputBlock = (_inputPosition - headBlockSize) / tailBlockSize - 3;
+    if (outputBlock < 0)
+    {
+        _isTailReady = false;
+        return;
+    }
+    
+    const auto block = kernel.blockOffset + outputBlock;
+    if (block == _heardTailBlock)
+        return;
+    
+    _heardTailBlock = block;
+    _isTailReady = kernel.tailReady[kernel.getTailSlot(block)].load(std::memory_order_acquire) == block;
+    if (!_isTailReady)
+    {
+        _numTailMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PartitionedConvolver::finishHeadBlock(Kernel& kernel, int numChannels)
+{
+    for (auto channel = 0; channel < numChannels; ++channel)
+    {
+        kernel.head.process(channel, kernel.getFilterChannel(channel), kernel.headInput[static_cast<size_t>(channel)].data(), kernel.headOutput[static_cast<size_t>(channel)].data());
+    }
+    
+    if (!kernel.hasTail() || _inputPosition % tailBlockSize != 0)
+        return;
+    
+    kernel.postTailBlock(kernel.blockOffset + _inputPosition / tailBlockSize - 1, numChannels);
+}
+
+void PartitionedConvolver::clearHistory()
+{
+    if (_kernel != nullptr)
+    {
+        _kernel->clearHead();
+        _kernel->restartTail(_inputPosition);
+    }
+    
+    resetTimeline();
+}
+
+void PartitionedConvolver::resetTimeline()
+{
+    for (auto& channel : _dryDelay)
+    {
+        channel.fill(0.0f);
+    }
+    
+    _inputPosition = 0;
+    _idleTracker.reset();
+    _heardTailBlock = -1;
+    _isTailReady = false;
+}
+
+void PartitionedConvolver::run()
+{
+    while (!threadShouldExit())
+    {
+        // Nothing is using a retired kernel once the loop is back here
+        _kernels.freeRetired();
+        
+        if (auto* kernel = _workerKernel.load(std::memory_order_acquire))
+        {
+            kernel->runTailJobs();
+        }
+        
+        wait(_pollIntervalMs);
+    }
+}
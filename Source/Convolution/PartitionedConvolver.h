@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+    
+    PartitionedConvolver.h
+    Created: 24 Oct 2026 11:20:43am
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Gain/Gain.h"
+#include "../Utils/AudioThreadHandover.h"
+#include "../Utils/IdleTracker.h"
+
+// Convolves the bus with a loaded impulse response, for cabinets and spaces. The first
+// _headLength samples (6144, three tail blocks) of the response run on the audio thread in
+// 128-sample partitions, which sets the latency. The rest runs in 2048-sample partitions
+// on a realtime worker thread.
+// Each tail block is posted once its input is complete and isn't heard until three blocks
+// later, which leaves the worker two blocks to finish it. The audio thread never waits on
+// the worker: a block that isn't ready in time is left out of the tail and counted as a
+// miss. Files are read, resampled and transformed on a loader thread, then swapped in at
+// the start of a block.
+class PartitionedConvolver : private juce::Thread
+{
+public:
+    static constexpr int headBlockSize = 128;
+    static constexpr int tailBlockSize = 2048;
+    
+    PartitionedConvolver();
+    ~PartitionedConvolver() override;
+    
+    void prepare(double sampleRate);
+    void reset();
+    
+    // Message thread
+    bool loadImpulseResponse(const juce::File& file);
+    void clearImpulseResponse();
+    void setEnabled(bool enabled);
+    void setMix(float mix);
+    int getLatencySamples() const;
+    
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+    bool isIdle() const;
+    double getTailLengthSeconds() const;
+    int getNumTailMisses() const;
+
+private:
+    struct Kernel;
+    
+    static constexpr int _maxChannels = 2;
+    static constexpr int _headLength = 3 * tailBlockSize; // Tail blocks are heard three blocks after posting, the head covers the gap
+    static constexpr double _maxImpulseSeconds = 10.0;
+    static constexpr float _trimThreshold = 1.0e-4f; // -80dB, quieter ends of the response are cut off
+    static constexpr float _mixRampSeconds = 0.05f;
+    static constexpr int _pollIntervalMs = 1;
+    
+    // Kernels are built on the loader thread and freed on the worker, never on the audio thread
+    std::unique_ptr<Kernel> _kernel;
+    std::atomic<Kernel*> _workerKernel = nullptr;
+    AudioThreadHandover<Kernel> _kernels;
+    
+    juce::ThreadPool _loader { 1 };
+    juce::CriticalSection _fileLock;
+    juce::File _file;
+    double _sampleRate = 0.0;
+    std::atomic<double> _impulseSeconds = 0.0; // Read by the host for the tail length
+    
+    // Without a response the dry signal still goes through the latency, so it never changes while enabled
+    std::array<std::array<float, headBlockSize>, _maxChannels> _dryDelay {};
+    std::array<float, headBlockSize> _input {};
+    std::array<float, headBlockSize> _wet {};
+    std::array<float, headBlockSize> _mixGains {};
+    int64_t _inputPosition = 0;
+    Gain _wetGain;
+    float _appliedMix = -1.0f;
+    bool _wasEnabled = false;
+    IdleTracker _idleTracker;
+    int64_t _heardTailBlock = -1;
+    bool _isTailReady = false;
+    std::atomic<int> _numTailMisses = 0;
+    
+    std::atomic<bool> _enabled = false;
+    std::atomic<float> _mix = 1.0f;
+    
+    // Helpers
+    void requestLoad(const juce::File& file, double sampleRate);
+    static std::unique_ptr<Kernel> createKernel(const juce::File& file, double sampleRate);
+    void swapPendingKernel();
+    void updateMix();
+    void mixChannel(float* samples, int channel, int position, int count, Kernel* kernel, bool isRamping);
+    void updateTailOutput(Kernel& kernel);
+    void finishHeadBlock(Kernel& kernel, int numChannels);
+    void clearHistory();
+    void resetTimeline();
+    void run() override;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolver)
+};
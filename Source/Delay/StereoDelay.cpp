@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    StereoDelay.cpp
+    Created: 22 Oct 2026 3:12:48pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "StereoDelay.h"
+
+void StereoDelay::prepare(double sampleRate)
+{
+    _sampleRate = sampleRate;
+    
+    // Room for the longest delay plus the extra sample the interpolation reads
+    const auto ringSize = juce::nextPowerOfTwo(static_cast<int>(std::ceil(maxDelaySeconds * sampleRate)) + 2);
+    _arena.assign(static_cast<size_t>(ringSize) * 2, 0.0f);
+    _left = _arena.data();
+    _right = _arena.data() + ringSize;
+    _ringMask = ringSize - 1;
+    
+    _lowCutCoefficient = static_cast<float>(std::exp(-juce::MathConstants<double>::twoPi * _lowCutHz / sampleRate));
+    _delaySamples.reset(sampleRate, _timeGlideSeconds);
+    _delaySamples.setCurrentAndTargetValue(static_cast<float>(getTargetDelaySeconds() * sampleRate));
+    
+    _appliedMix = -1.0f;
+    _appliedTone = -1.0f;
+    _wetGain.reset(0.0f);
+    reset();
+}
+
+void StereoDelay::reset()
+{
+    std::fill(_arena.begin(), _arena.end(), 0.0f);
+    _writePosition = 0;
+    _toneStates.fill(0.0f);
+    _lowCutStates.fill(0.0f);
+    _idleTracker.reset();
+}
+
+void StereoDelay::setMix(float mix)
+{
+    _mix.store(std::clamp(mix, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void StereoDelay::setFeedback(float feedback)
+{
+    _feedback.store(std::clamp(feedback, 0.0f, _maxFeedback), std::memory_order_relaxed);
+}
+
+void StereoDelay::setTone(float tone)
+{
+    _tone.store(std::clamp(tone, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void StereoDelay::setPingPong(bool enabled)
+{
+    _pingPong.store(enabled, std::memory_order_relaxed);
+}
+
+void StereoDelay::setSync(bool enabled)
+{
+    _sync.store(enabled, std::memory_order_relaxed);
+}
+
+void StereoDelay::setDivision(int index)
+{
+    _division.store(std::clamp(index, 0, static_cast<int>(divisionBeats.size()) - 1), std::memory_order_relaxed);
+}
+
+void StereoDelay::setTime(float milliseconds)
+{
+    _timeMilliseconds.store(milliseconds, std::memory_order_relaxed);
+}
+
+void StereoDelay::setTempo(double bpm)
+{
+    if (bpm > 0.0)
+    {
+        _tempo = bpm;
+    }
+}
+
+void StereoDelay::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    if (_left == nullptr)
+        return;
+    
+    updateParameters();
+    
+    // Once the delay is off, nothing new goes in and the repeats already in the ring run out unheard
+    const auto inputGain = _wetGain.isSilent() ? 0.0f : 1.0f;
+    auto* left = buffer.getWritePointer(0);
+    auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : left;
+    
+    if (!_idleTracker.startBlock(IdleTracker::getPeak(buffer, 2, numSamples) * inputGain))
+        return;
+    
+    const auto feedback = _feedback.load(std::memory_order_relaxed);
+    const auto pingPong = _pingPong.load(std::memory_order_relaxed);
+    auto outputPeak = 0.0f;
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        // Read between the two samples either side of the delay time
+        const auto delaySamples = _delaySamples.getNextValue();
+        const auto wholeSamples = static_cast<int>(delaySamples);
+        const auto fraction = delaySamples - static_cast<float>(wholeSamples);
+        const auto newer = (_writePosition - wholeSamples) & _ringMask;
+        const auto older = (newer - 1) & _ringMask;
+        const auto delayedLeft = _left[newer] + fraction * (_left[older] - _left[newer]);
+        const auto delayedRight = _right[newer] + fraction * (_right[older] - _right[newer]);
+        
+        const auto feedbackLeft = filterFeedback(delayedLeft, 0) * feedback;
+        const auto feedbackRight = filterFeedback(delayedRight, 1) * feedback;
+        const auto inputLeft = left[i] * inputGain;
+        const auto inputRight = right[i] * inputGain;
+        
+        // Ping-pong starts every echo on the left and swaps sides each repeat
+        if (pingPong)
+        {
+            _left[_writePosition] = 0.5f * (inputLeft + inputRight) + feedbackRight;
+            _right[_writePosition] = feedbackLeft;
+        }
+        else
+        {
+            _left[_writePosition] = inputLeft + feedbackLeft;
+            _right[_writePosition] = inputRight + feedbackRight;
+        }
+        
+        _writePosition = (_writePosition + 1) & _ringMask;
+        
+        const auto gain = _wetGain.getNextSample();
+        left[i] += delayedLeft * gain;
+        if (right != left)
+        {
+            right[i] += delayedRight * gain;
+        }
+        
+        outputPeak = std::max({ outputPeak, std::abs(delayedLeft), std::abs(delayedRight) });
+    }
+    
+    // A whole ring of silence means nothing audible is left anywhere, however the time changes later
+    if (_idleTracker.endBlock(numSamples, _ringMask + 1, outputPeak))
+    {
+        _toneStates.fill(0.0f);
+        _lowCutStates.fill(0.0f);
+    }
+}
+
+bool StereoDelay::isIdle() const
+{
+    return _idleTracker.isIdle();
+}
+
+// Time for the repeats to fall by 60dB
+double StereoDelay::getTailLengthSeconds() const
+{
+    if (_mix.load(std::memory_order_relaxed) <= 0.0f)
+        return 0.0;
+    
+    const auto delaySeconds = _currentDelaySeconds.load(std::memory_order_relaxed);
+    const auto feedback = static_cast<double>(_feedback.load(std::memory_order_relaxed));
+    if (feedback <= 0.0)
+        return delaySeconds;
+    
+    return delaySeconds * (1.0 + std::log(0.001) / std::log(feedback));
+}
+
+void StereoDelay::updateParameters()
+{
+    const auto mix = _mix.load(std::memory_order_relaxed);
+    if (mix != _appliedMix)
+    {
+        _wetGain.setTargetGain(mix, _mixRampSeconds, _sampleRate);
+        _appliedMix = mix;
+    }
+    
+    // Full tone leaves the repeats open, zero closes the feedback lowpass down to 1kHz
+    const auto tone = _tone.load(std::memory_order_relaxed);
+    if (tone != _appliedTone)
+    {
+        const auto cutoff = std::min(1000.0 * std::pow(20.0, static_cast<double>(tone)), 0.45 * _sampleRate);
+        _toneCoefficient = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * cutoff / _sampleRate));
+        _appliedTone = tone;
+    }
+    
+    const auto delaySeconds = getTargetDelaySeconds();
+    _currentDelaySeconds.store(delaySeconds, std::memory_order_relaxed);
+    const auto delaySamples = static_cast<float>(delaySeconds * _sampleRate);
+    if (delaySamples != _delaySamples.getTargetValue())
+    {
+        // An idle delay has nothing to glide through, so it jumps straight to the new time
+        if (_idleTracker.isIdle())
+        {
+            _delaySamples.setCurrentAndTargetValue(delaySamples);
+        }
+        else
+        {
+            _delaySamples.setTargetValue(delaySamples);
+        }
+    }
+}
+
+double StereoDelay::getTargetDelaySeconds() const
+{
+    auto seconds = static_cast<double>(_timeMilliseconds.load(std::memory_order_relaxed)) * 0.001;
+    if (_sync.load(std::memory_order_relaxed))
+    {
+        seconds = divisionBeats[static_cast<size_t>(_division.load(std::memory_order_relaxed))] * 60.0 / _tempo;
+    }
+    
+    return std::clamp(seconds, _minDelaySeconds, maxDelaySeconds);
+}
+
+float StereoDelay::filterFeedback(float sample, size_t channel)
+{
+    auto& tone = _toneStates[channel];
+    tone += _toneCoefficient * (sample - tone);
+    
+    // Highpass as the input minus its own lowpassed copy
+    auto& lowCut = _lowCutStates[channel];
+    lowCut = tone + _lowCutCoefficient * (lowCut - tone);
+    return tone - lowCut;
+}
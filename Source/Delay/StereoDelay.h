@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    StereoDelay.h
+    Created: 22 Oct 2026 3:12:48pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Gain/Gain.h"
+#include "../Utils/IdleTracker.h"
+
+// Stereo or ping-pong echo for the summed bus. The delay time is either free or a note
+// division of the host tempo. Time changes glide, and reads interpolate between
+// samples, so a tempo change bends the repeats instead of clicking. Both channels share
+// one ring sized for the longest delay at prepare time, so nothing allocates while
+// playing. The feedback path is band-limited so repeats darken as they fade.
+class StereoDelay
+{
+public:
+    static constexpr double maxDelaySeconds = 4.0;
+    static constexpr std::array<double, 12> divisionBeats { 0.125, 1.0 / 6.0, 0.25, 0.375, 1.0 / 3.0, 0.5, 0.75, 2.0 / 3.0, 1.0, 1.5, 2.0, 4.0 };
+    
+    StereoDelay() = default;
+    
+    void prepare(double sampleRate);
+    void reset();
+    
+    // Message thread
+    void setMix(float mix);
+    void setFeedback(float feedback);
+    void setTone(float tone);
+    void setPingPong(bool enabled);
+    void setSync(bool enabled);
+    void setDivision(int index);
+    void setTime(float milliseconds);
+    
+    // Audio thread, from the host's play head
+    void setTempo(double bpm);
+    
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+    bool isIdle() const;
+    double getTailLengthSeconds() const;
+    
+private:
+    static constexpr float _maxFeedback = 0.95f;
+    static constexpr double _minDelaySeconds = 0.001;
+    static constexpr double _timeGlideSeconds = 0.2;
+    static constexpr double _lowCutHz = 80.0;
+    static constexpr float _mixRampSeconds = 0.05f;
+    
+    // Ring arena, left channel then right, each a power of two long
+    std::vector<float> _arena;
+    float* _left = nullptr;
+    float* _right = nullptr;
+    int _ringMask = 0;
+    int _writePosition = 0;
+    
+    double _sampleRate = 44100.0;
+    double _tempo = 120.0;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> _delaySamples;
+    Gain _wetGain;
+    
+    // Feedback filters per channel: a one-pole lowpass for the tone and a one-pole highpass against rumble
+    std::array<float, 2> _toneStates {};
+    std::array<float, 2> _lowCutStates {};
+    float _toneCoefficient = 1.0f;
+    float _lowCutCoefficient = 0.0f;
+    
+    IdleTracker _idleTracker;
+    
+    std::atomic<float> _mix = 0.0f;
+    std::atomic<float> _feedback = 0.4f;
+    std::atomic<float> _tone = 0.6f;
+    std::atomic<bool> _pingPong = false;
+    std::atomic<bool> _sync = true;
+    std::atomic<int> _division = 5; // 1/8
+    std::atomic<float> _timeMilliseconds = 375.0f;
+    std::atomic<double> _currentDelaySeconds = 0.25; // Read by the host for the tail length
+    float _appliedMix = -1.0f;
+    float _appliedTone = -1.0f;
+    
+    // Helpers
+    void updateParameters();
+    double getTargetDelaySeconds() const;
+    float filterFeedback(float sample, size_t channel);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StereoDelay)
+};
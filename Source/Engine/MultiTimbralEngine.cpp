@@ -0,0 +1,426 @@
+/*
+  ==============================================================================
+
+    MultiTimbralEngine.cpp
+    Created: 20 Oct 2026 10:48:15am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "MultiTimbralEngine.h"
+
+MultiTimbralEngine::MultiTimbralEngine()
+    : _sharedTuning(std::make_shared<SharedTuning>())
+{
+    for (auto& part : _parts)
+    {
+        part = std::make_unique<SynthEngine>(_sharedTuning);
+        part->setSampleStreamer(&_sampleStreamer);
+    }
+    
+    for (auto& polyphony : _partPolyphony)
+    {
+        polyphony.store(_maxVoicesPerPart);
+    }
+}
+
+void MultiTimbralEngine::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    for (auto i = 0; i < numParts; ++i)
+    {
+        _parts[static_cast<size_t>(i)]->prepareToPlay(sampleRate, samplesPerBlock);
+        _partMidi[static_cast<size_t>(i)].ensureSize(_partMidiBytes);
+    }
+    
+    _partBuffer.setSize(2, std::max(1, samplesPerBlock));
+    _governor.prepare(sampleRate);
+    _sampleStreamer.prepare();
+    for (auto& saturator : _busSaturators)
+    {
+        saturator.prepare(sampleRate);
+    }
+    
+    _convolver.prepare(sampleRate);
+    _chorus.prepare(sampleRate);
+    _delay.prepare(sampleRate);
+    _reverb.prepare(sampleRate);
+    _limiter.prepare(sampleRate, 2);
+}
+
+void MultiTimbralEngine::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    
+    // Offline rendering has no deadline, so it always runs at full quality
+    const auto isGoverned = !_isNonRealtime.load(std::memory_order_relaxed) && _loadReductionEnabled.load(std::memory_order_relaxed);
+    const auto loadReduction = isGoverned ? _governor.getLevel() : 0;
+    for (auto& part : _parts)
+    {
+        part->setLoadReduction(loadReduction);
+    }
+    
+    _sampleStreamer.update();
+    
+    // Idle fast path: nothing sounding, nothing to play and every effect tail has died away
+    if (isSilent() && midiMessages.isEmpty())
+    {
+        buffer.clear();
+        _governor.reset();
+        return;
+    }
+    
+    renderParts(buffer, midiMessages);
+    renderEffects(buffer);
+    
+    if (isGoverned)
+    {
+        _governor.update(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks), buffer.getNumSamples());
+    }
+    else
+    {
+        _governor.reset();
+    }
+}
+
+void MultiTimbralEngine::renderParts(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    
+    auto& firstPart = *_parts[0];
+    if (!_multiTimbral.load(std::memory_order_relaxed))
+    {
+        // Part 1 renders straight into the output, the others only play out notes left from multi-timbral mode
+        firstPart.setVoiceLimit(_partPolyphony[0].load(std::memory_order_relaxed));
+        firstPart.processBlock(buffer, midiMessages);
+        _isSilent = firstPart.isSilent();
+        
+        for (auto i = 1; i < numParts; ++i)
+        {
+            renderPart(i, _emptyMidi, buffer);
+        }
+        
+        return;
+    }
+    
+    buffer.clear();
+    _isSilent = true;
+    splitMidiByChannel(midiMessages);
+    
+    std::array<int, numParts> voiceLimits;
+    shareVoiceBudget(voiceLimits);
+    for (auto i = 0; i < numParts; ++i)
+    {
+        _parts[static_cast<size_t>(i)]->setVoiceLimit(voiceLimits[static_cast<size_t>(i)]);
+        renderPart(i, _partMidi[static_cast<size_t>(i)], buffer);
+    }
+}
+
+// Each part asks for a voice per note-on in its MIDI, up to its own polyphony. When the free
+// voices can't cover every request they are shared in proportion to it, and the few left over
+// from rounding down go one each to the parts in turn, starting one part further on each block
+void MultiTimbralEngine::shareVoiceBudget(std::array<int, numParts>& voiceLimits)
+{
+    std::array<int, numParts> demand;
+    auto totalDemand = 0;
+    for (auto i = 0; i < numParts; ++i)
+    {
+        const auto index = static_cast<size_t>(i);
+        const auto activeVoices = _parts[index]->getNumActiveVoices();
+        auto numNoteOns = 0;
+        for (const auto metadata : _partMidi[index])
+        {
+            if (metadata.getMessage().isNoteOn())
+            {
+                ++numNoteOns;
+            }
+        }
+        
+        demand[index] = std::min(numNoteOns, std::max(0, _partPolyphony[index].load(std::memory_order_relaxed) - activeVoices));
+        voiceLimits[index] = activeVoices;
+        totalDemand += demand[index];
+    }
+    
+    const auto freeVoices = std::max(0, _voiceBudget.load(std::memory_order_relaxed) - getNumActiveVoices());
+    if (totalDemand <= freeVoices)
+    {
+        for (auto i = 0; i < numParts; ++i)
+        {
+            voiceLimits[static_cast<size_t>(i)] += demand[static_cast<size_t>(i)];
+        }
+        
+        return;
+    }
+    
+    auto grantedVoices = 0;
+    std::array<int, numParts> grants;
+    for (auto i = 0; i < numParts; ++i)
+    {
+        grants[static_cast<size_t>(i)] = demand[static_cast<size_t>(i)] * freeVoices / totalDemand;
+        grantedVoices += grants[static_cast<size_t>(i)];
+    }
+    
+    // Every part rounded down lost less than one voice, so a single pass hands out the rest
+    for (auto n = 0; n < numParts && grantedVoices < freeVoices; ++n)
+    {
+        const auto index = static_cast<size_t>((_firstServedPart + n) % numParts);
+        if (grants[index] < demand[index])
+        {
+            ++grants[index];
+            ++grantedVoices;
+        }
+    }
+    
+    _firstServedPart = (_firstServedPart + 1) % numParts;
+    for (auto i = 0; i < numParts; ++i)
+    {
+        voiceLimits[static_cast<size_t>(i)] += grants[static_cast<size_t>(i)];
+    }
+}
+
+void MultiTimbralEngine::renderEffects(juce::AudioBuffer<float>& buffer)
+{
+    juce::ScopedNoDenormals noDenormals;
+    
+    const auto numSamples = buffer.getNumSamples();
+    for (auto channel = 0; channel < std::min(buffer.getNumChannels(), static_cast<int>(_busSaturators.size())); ++channel)
+    {
+        auto& saturator = _busSaturators[static_cast<size_t>(channel)];
+        if (!_isSilent || !saturator.isSettled())
+        {
+            saturator.processBlock(buffer.getWritePointer(channel), numSamples);
+        }
+    }
+    
+    // Straight after the drive, the way a cabinet follows an amp
+    _convolver.process(buffer, numSamples);
+    _chorus.process(buffer, numSamples);
+    _delay.process(buffer, numSamples);
+    _reverb.process(buffer, numSamples);
+    
+    _limiter.setLookahead(_limiterLookahead.load(std::memory_order_relaxed));
+    if (!_isSilent || !areEffectsIdle() || !_limiter.isIdle())
+    {
+        _limiter.process(buffer, numSamples);
+    }
+}
+
+bool MultiTimbralEngine::areEffectsIdle() const
+{
+    const auto saturatorsSettled = std::all_of(_busSaturators.begin(), _busSaturators.end(), [](const Saturator& saturator) { return saturator.isSettled(); });
+    return saturatorsSettled && _convolver.isIdle() && _chorus.isIdle() && _delay.isIdle() && _reverb.isIdle();
+}
+
+void MultiTimbralEngine::reset()
+{
+    for (auto& part : _parts)
+    {
+        part->reset();
+    }
+    
+    _governor.reset();
+    for (auto& saturator : _busSaturators)
+    {
+        saturator.reset();
+    }
+    
+    _convolver.reset();
+    _chorus.reset();
+    _delay.reset();
+    _reverb.reset();
+    _limiter.reset();
+}
+
+SynthEngine& MultiTimbralEngine::getPart(int index)
+{
+    return *_parts[static_cast<size_t>(std::clamp(index, 0, numParts - 1))];
+}
+
+void MultiTimbralEngine::setMultiTimbral(bool enabled)
+{
+    _multiTimbral.store(enabled, std::memory_order_relaxed);
+}
+
+bool MultiTimbralEngine::isMultiTimbral() const
+{
+    return _multiTimbral.load(std::memory_order_relaxed);
+}
+
+void MultiTimbralEngine::setPartPolyphony(int index, int voices)
+{
+    if (!juce::isPositiveAndBelow(index, numParts))
+        return;
+    
+    _partPolyphony[static_cast<size_t>(index)].store(std::clamp(voices, 1, _maxVoicesPerPart), std::memory_order_relaxed);
+}
+
+void MultiTimbralEngine::setVoiceBudget(int voices)
+{
+    _voiceBudget.store(std::max(1, voices), std::memory_order_relaxed);
+}
+
+void MultiTimbralEngine::setOversampling(EngineUtils::OversamplingFactor realtime, EngineUtils::OversamplingFactor offline)
+{
+    for (auto& part : _parts)
+    {
+        part->setOversampling(realtime, offline);
+    }
+}
+
+void MultiTimbralEngine::setNonRealtime(bool isNonRealtime)
+{
+    _isNonRealtime.store(isNonRealtime, std::memory_order_relaxed);
+    for (auto& part : _parts)
+    {
+        part->setNonRealtime(isNonRealtime);
+    }
+}
+
+int MultiTimbralEngine::getLatencySamples() const
+{
+    return _parts[0]->getLatencySamples() + _convolver.getLatencySamples() + Limiter::getLatencySamples(_limiterLookahead.load(std::memory_order_relaxed));
+}
+
+void MultiTimbralEngine::setLoadReductionEnabled(bool enabled)
+{
+    _loadReductionEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void MultiTimbralEngine::setLimiterLookahead(bool enabled)
+{
+    _limiterLookahead.store(enabled, std::memory_order_relaxed);
+}
+
+void MultiTimbralEngine::setBusDrive(float amount, EngineUtils::SaturationShape shape)
+{
+    for (auto& saturator : _busSaturators)
+    {
+        saturator.setShape(shape);
+        saturator.setDrive(amount);
+    }
+}
+
+PartitionedConvolver& MultiTimbralEngine::getConvolver()
+{
+    return _convolver;
+}
+
+EnsembleChorus& MultiTimbralEngine::getChorus()
+{
+    return _chorus;
+}
+
+StereoDelay& MultiTimbralEngine::getDelay()
+{
+    return _delay;
+}
+
+FdnReverb& MultiTimbralEngine::getReverb()
+{
+    return _reverb;
+}
+
+SampleStreamer& MultiTimbralEngine::getSampleStreamer()
+{
+    return _sampleStreamer;
+}
+
+void MultiTimbralEngine::setTempo(double bpm)
+{
+    _delay.setTempo(bpm);
+}
+
+void MultiTimbralEngine::setTuning(const TuningTable& tuning)
+{
+    _sharedTuning->setTuning(tuning);
+}
+
+const TuningTable& MultiTimbralEngine::getTuning() const
+{
+    return _sharedTuning->getTuning();
+}
+
+void MultiTimbralEngine::setPitchRange(float semitones)
+{
+    _sharedTuning->setPitchBendRange(semitones);
+}
+
+bool MultiTimbralEngine::isSilent() const
+{
+    return _isSilent && areEffectsIdle() && _limiter.isIdle();
+}
+
+double MultiTimbralEngine::getTailLengthSeconds() const
+{
+    auto tailLength = 0.0;
+    for (const auto& part : _parts)
+    {
+        tailLength = std::max(tailLength, part->getTailLengthSeconds());
+    }
+    
+    return tailLength + _convolver.getTailLengthSeconds() + _delay.getTailLengthSeconds() + _reverb.getTailLengthSeconds();
+}
+
+bool MultiTimbralEngine::isNoteBookkeepingConsistent() const
+{
+    return std::all_of(_parts.begin(), _parts.end(), [](const std::unique_ptr<SynthEngine>& part) { return part->isNoteBookkeepingConsistent(); });
+}
+
+void MultiTimbralEngine::splitMidiByChannel(const juce::MidiBuffer& midiMessages)
+{
+    for (auto& partMidi : _partMidi)
+    {
+        partMidi.clear();
+    }
+    
+    // Channel-less messages (sysex, clock) aren't used by the parts and are dropped
+    for (const auto metadata : midiMessages)
+    {
+        const auto channel = metadata.getMessage().getChannel();
+        if (channel > 0)
+        {
+            _partMidi[static_cast<size_t>(channel - 1)].addEvent(metadata.data, metadata.numBytes, metadata.samplePosition);
+        }
+    }
+}
+
+void MultiTimbralEngine::renderPart(int index, juce::MidiBuffer& midiMessages, juce::AudioBuffer<float>& buffer)
+{
+    auto& part = *_parts[static_cast<size_t>(index)];
+    
+    // A part with nothing sounding and nothing to do is skipped; it picks up tuning and play mode changes on its next block
+    if (part.isSilent() && midiMessages.isEmpty())
+        return;
+    
+    // The part buffer holds one prepared block, longer host blocks are split rather than growing it.
+    // Parts read their MIDI at the start of a block, so the whole buffer goes with the first chunk
+    const auto numChannels = std::min(buffer.getNumChannels(), _partBuffer.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+    const auto chunkSize = _partBuffer.getNumSamples();
+    for (auto startSample = 0; startSample < numSamples; startSample += chunkSize)
+    {
+        const auto chunkLength = std::min(chunkSize, numSamples - startSample);
+        juce::AudioBuffer<float> chunk(_partBuffer.getArrayOfWritePointers(), numChannels, chunkLength);
+        part.processBlock(chunk, startSample == 0 ? midiMessages : _emptyMidi);
+        if (part.isSilent())
+            continue;
+        
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            buffer.addFrom(channel, startSample, chunk, channel, 0, chunkLength);
+        }
+        
+        _isSilent = false;
+    }
+}
+
+int MultiTimbralEngine::getNumActiveVoices() const
+{
+    auto activeVoices = 0;
+    for (const auto& part : _parts)
+    {
+        activeVoices += part->getNumActiveVoices();
+    }
+    
+    return activeVoices;
+}
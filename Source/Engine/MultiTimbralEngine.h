@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    MultiTimbralEngine.h
+    Created: 20 Oct 2026 10:48:15am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SynthEngine.h"
+#include "RenderGovernor.h"
+#include "../Tuning/SharedTuning.h"
+#include "../Limiter/Limiter.h"
+#include "../Reverb/FdnReverb.h"
+#include "../Delay/StereoDelay.h"
+#include "../Chorus/EnsembleChorus.h"
+#include "../Saturator/Saturator.h"
+#include "../Convolution/PartitionedConvolver.h"
+#include "../Sampler/SampleStreamer.h"
+
+// Up to 16 parts, each a SynthEngine with its own patch and voice pool. In multi-timbral
+// mode MIDI channel n plays part n; otherwise every channel plays part 1 as before. The
+// parts share one tuning (and the oscillators' static tables) and draw their voices from
+// a global budget, shared out by demand, so a busy part can't starve the CPU or the other
+// parts. Live rendering is timed every block and the parts render cheaper while it nears
+// the deadline. The summed output goes through the bus effects and then a peak limiter as
+// the master stage.
+class MultiTimbralEngine
+{
+public:
+    static constexpr int numParts = 16;
+    
+    MultiTimbralEngine();
+    
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+    void reset();
+    
+    // Patches are set on the parts directly, part 0 is the one heard outside multi-timbral mode
+    SynthEngine& getPart(int index);
+    
+    void setMultiTimbral(bool enabled);
+    bool isMultiTimbral() const;
+    void setPartPolyphony(int index, int voices);
+    void setVoiceBudget(int voices);
+    
+    // Oversampling applies to every part
+    void setOversampling(EngineUtils::OversamplingFactor realtime, EngineUtils::OversamplingFactor offline);
+    void setNonRealtime(bool isNonRealtime);
+    int getLatencySamples() const;
+    
+    // On by default. Replays turn it off so their output doesn't depend on the machine's speed
+    void setLoadReductionEnabled(bool enabled);
+    
+    // Lookahead delays the output so the limiter can fade into peaks instead of stepping
+    void setLimiterLookahead(bool enabled);
+    
+    // Bus effects, message thread
+    void setBusDrive(float amount, EngineUtils::SaturationShape shape);
+    PartitionedConvolver& getConvolver();
+    EnsembleChorus& getChorus();
+    StereoDelay& getDelay();
+    FdnReverb& getReverb();
+    
+    // Samples for oscillators set to Sample, shared by every part
+    SampleStreamer& getSampleStreamer();
+    
+    // Audio thread, host tempo for the synced effects
+    void setTempo(double bpm);
+    
+    // Tuning shared by every part, message thread only
+    void setTuning(const TuningTable& tuning);
+    const TuningTable& getTuning() const;
+    void setPitchRange(float semitones);
+    
+    // Idle state
+    bool isSilent() const;
+    double getTailLengthSeconds() const;
+    
+    // Debug checks, see SynthEngine
+    bool isNoteBookkeepingConsistent() const;
+    
+private:
+    std::shared_ptr<SharedTuning> _sharedTuning;
+    SampleStreamer _sampleStreamer; // Declared ahead of the parts so it outlives their voices
+    std::array<std::unique_ptr<SynthEngine>, numParts> _parts;
+    std::array<juce::MidiBuffer, numParts> _partMidi;
+    juce::MidiBuffer _emptyMidi;
+    juce::AudioBuffer<float> _partBuffer;
+    bool _isSilent = true;
+    
+    std::atomic<bool> _multiTimbral = false;
+    std::array<std::atomic<int>, numParts> _partPolyphony;
+    std::atomic<int> _voiceBudget = _defaultVoiceBudget;
+    std::atomic<bool> _isNonRealtime = false;
+    std::atomic<bool> _loadReductionEnabled = true;
+    int _firstServedPart = 0; // Rotates so voices left over from sharing out the budget go round the parts
+    RenderGovernor _governor;
+    std::array<Saturator, 2> _busSaturators; // One per channel
+    PartitionedConvolver _convolver;
+    EnsembleChorus _chorus;
+    StereoDelay _delay;
+    FdnReverb _reverb;
+    Limiter _limiter;
+    std::atomic<bool> _limiterLookahead = true;
+    static_assert(RenderGovernor::maxLevel == SynthEngine::maxLoadReduction, "Every governor level needs a part setting");
+    
+    static constexpr int _defaultVoiceBudget = 32;
+    static constexpr int _maxVoicesPerPart = 8;
+    static constexpr size_t _partMidiBytes = 4096; // Reserved per part so routing doesn't allocate
+    
+    // Helpers
+    void renderParts(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+    void renderEffects(juce::AudioBuffer<float>& buffer);
+    bool areEffectsIdle() const;
+    void splitMidiByChannel(const juce::MidiBuffer& midiMessages);
+    void shareVoiceBudget(std::array<int, numParts>& voiceLimits);
+    void renderPart(int index, juce::MidiBuffer& midiMessages, juce::AudioBuffer<float>& buffer);
+    int getNumActiveVoices() const;
+};
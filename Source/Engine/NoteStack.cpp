@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    NoteStack.cpp
+    Created: 19 Oct 2026 4:41:05pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "NoteStack.h"
+#include <algorithm>
+
+void NoteStack::push(int midiNote, float velocity)
+{
+    // A re-pressed key moves to the top
+    remove(midiNote);
+    if (_size == maxNotes)
+        return;
+
+    _entries[static_cast<size_t>(_size)] = { midiNote, velocity };
+    ++_size;
+}
+
+void NoteStack::remove(int midiNote)
+{
+    const auto index = indexOf(midiNote);
+    if (index < 0)
+        return;
+
+    std::copy(_entries.begin() + index + 1, _entries.begin() + _size, _entries.begin() + index);
+    --_size;
+}
+
+void NoteStack::clear()
+{
+    _size = 0;
+}
+
+bool NoteStack::isEmpty() const
+{
+    return _size == 0;
+}
+
+float NoteStack::getVelocity(int midiNote) const
+{
+    const auto index = indexOf(midiNote);
+    return index >= 0 ? _entries[static_cast<size_t>(index)].velocity : 0.0f;
+}
+
+int NoteStack::getPriorityNotes(EngineUtils::NotePriority priority, int* notes, int maxCount) const
+{
+    // maxCount is the number of mono voices, so a selection scan per slot is cheapest
+    auto count = 0;
+    while (count < maxCount && count < _size)
+    {
+        auto best = -1;
+        for (auto i = _size - 1; i >= 0; --i)
+        {
+            const auto alreadyChosen = std::find(notes, notes + count, _entries[static_cast<size_t>(i)].midiNote) != notes + count;
+            if (!alreadyChosen && (best < 0 || isPreferred(priority, i, best)))
+            {
+                best = i;
+            }
+        }
+
+        notes[count] = _entries[static_cast<size_t>(best)].midiNote;
+        ++count;
+    }
+
+    return count;
+}
+
+int NoteStack::indexOf(int midiNote) const
+{
+    for (auto i = 0; i < _size; ++i)
+    {
+        if (_entries[static_cast<size_t>(i)].midiNote == midiNote)
+            return i;
+    }
+
+    return -1;
+}
+
+bool NoteStack::isPreferred(EngineUtils::NotePriority priority, int candidateIndex, int currentIndex) const
+{
+    // Pitch priority compares the notes, whichever channel they came in on
+    const auto candidate = _entries[static_cast<size_t>(candidateIndex)].midiNote % notesPerChannel;
+    const auto current = _entries[static_cast<size_t>(currentIndex)].midiNote % notesPerChannel;
+
+    switch (priority)
+    {
+        case EngineUtils::NotePriority::Low:
+            return candidate < current;
+        case EngineUtils::NotePriority::High:
+            return candidate > current;
+        case EngineUtils::NotePriority::Last:
+        default:
+            return candidateIndex > currentIndex;
+    }
+}
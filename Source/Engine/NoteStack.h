@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    NoteStack.h
+    Created: 19 Oct 2026 4:41:05pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include "../Utils/EngineUtils.h"
+
+// Held keys in the order they were pressed, for the mono and duo play modes.
+// Fixed size, so pushing and removing never allocate on the audio thread.
+// Under MPE a key is the note plus 128 per channel, as numbered by SynthEngine.
+class NoteStack
+{
+public:
+    static constexpr int maxNotes = 128;
+    static constexpr int notesPerChannel = 128;
+
+    void push(int midiNote, float velocity);
+    void remove(int midiNote);
+    void clear();
+    bool isEmpty() const;
+    float getVelocity(int midiNote) const;
+
+    // Fills notes with up to maxCount held keys, highest priority first. Returns how many were written
+    int getPriorityNotes(EngineUtils::NotePriority priority, int* notes, int maxCount) const;
+
+private:
+    struct Entry
+    {
+        int midiNote = -1;
+        float velocity = 0.0f;
+    };
+
+    std::array<Entry, maxNotes> _entries; // Oldest first
+    int _size = 0;
+
+    // Helpers
+    int indexOf(int midiNote) const;
+    bool isPreferred(EngineUtils::NotePriority priority, int candidateIndex, int currentIndex) const;
+};
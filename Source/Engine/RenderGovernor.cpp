@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    RenderGovernor.cpp
+    Created: 21 Oct 2026 9:37:44am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "RenderGovernor.h"
+
+void RenderGovernor::prepare(double sampleRate)
+{
+    _sampleRate = sampleRate;
+    reset();
+}
+
+void RenderGovernor::reset()
+{
+    _averageLoad = 0.0;
+    _level = 0;
+    _secondsSinceChange = 0.0;
+}
+
+void RenderGovernor::update(double renderSeconds, int numSamples)
+{
+    if (numSamples <= 0 || _sampleRate <= 0.0)
+        return;
+    
+    // Exponential moving average, weighted by how much time the block covers
+    const auto blockSeconds = numSamples / _sampleRate;
+    const auto weight = 1.0 - std::exp(-blockSeconds / _averagingSeconds);
+    _averageLoad += weight * (renderSeconds / blockSeconds - _averageLoad);
+    _secondsSinceChange += blockSeconds;
+    
+    if (_averageLoad > _reduceLoad && _level < maxLevel && _secondsSinceChange >= _reduceSeconds)
+    {
+        ++_level;
+        _secondsSinceChange = 0.0;
+    }
+    else if (_averageLoad > _restoreLoad)
+    {
+        // Not quiet enough to restore, start the hold over
+        _secondsSinceChange = std::min(_secondsSinceChange, _reduceSeconds);
+    }
+    else if (_level > 0 && _secondsSinceChange >= _restoreSeconds)
+    {
+        --_level;
+        _secondsSinceChange = 0.0;
+    }
+}
+
+int RenderGovernor::getLevel() const
+{
+    return _level;
+}
+
+double RenderGovernor::getAverageLoad() const
+{
+    return _averageLoad;
+}
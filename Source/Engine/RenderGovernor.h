@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    RenderGovernor.h
+    Created: 21 Oct 2026 9:37:44am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Tracks how much of each block's deadline rendering takes and turns that into a load
+// reduction level for the engine. The load is averaged over a fixed time rather than a
+// fixed number of blocks, so small and large host buffers react alike. Levels step up
+// quickly when the average nears the deadline and come back one at a time, only after
+// the load has stayed low for a while, so quality doesn't flap around a threshold.
+class RenderGovernor
+{
+public:
+    static constexpr int maxLevel = 3;
+    
+    void prepare(double sampleRate);
+    void reset();
+    
+    // Audio thread, once per block with the time the block took to render
+    void update(double renderSeconds, int numSamples);
+    int getLevel() const;
+    double getAverageLoad() const; // Share of the deadline, 1 = rendering took the whole block
+    
+private:
+    double _sampleRate = 44100.0;
+    double _averageLoad = 0.0;
+    int _level = 0;
+    double _secondsSinceChange = 0.0;
+    
+    static constexpr double _averagingSeconds = 0.1;
+    static constexpr double _reduceLoad = 0.75;  // Above this the level steps up
+    static constexpr double _restoreLoad = 0.45; // Below this, held for _restoreSeconds, it steps down
+    static constexpr double _reduceSeconds = 0.05; // Gives the last step time to show in the average
+    static constexpr double _restoreSeconds = 2.0;
+};
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    RenderQuality.h
+    Created: 20 Oct 2026 4:52:19pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <algorithm>
+#include "../Utils/EngineUtils.h"
+#include "../Oversampler/Oversampler.h"
+
+// Everything the engine can trade for CPU. Live playback uses the realtime profile; while
+// the host renders offline (isNonRealtime) the engine switches to the offline profile,
+// which spends whatever it takes on fidelity.
+struct RenderQuality
+{
+    EngineUtils::OversamplingFactor oversampling = EngineUtils::OversamplingFactor::Off;
+    Oversampler::Filter oversamplingFilter = Oversampler::Filter::PolyphaseIir;
+    int controlBlockSize = 32; // Samples between glide, pitch bend and expression updates
+    
+    static RenderQuality realtime(EngineUtils::OversamplingFactor oversampling)
+    {
+        return { oversampling, Oversampler::Filter::PolyphaseIir, 32 };
+    }
+    
+    // Linear-phase decimation and near per-sample modulation
+    static RenderQuality offline(EngineUtils::OversamplingFactor oversampling)
+    {
+        return { oversampling, Oversampler::Filter::LinearPhaseFir, 4 };
+    }
+    
+    // Cheaper settings under load: each level doubles the control block, and from level 2 each
+    // level also halves the oversampling. The filter restarts when the factor changes, so that is
+    // kept for sustained overload. Only the realtime profile is governed, where the polyphase
+    // filters keep the latency change to a sample or two
+    RenderQuality reducedBy(int level) const
+    {
+        auto quality = *this;
+        quality.controlBlockSize = controlBlockSize << std::max(0, level);
+        
+        const auto oversamplingSteps = static_cast<int>(oversampling) - std::max(0, level - 1);
+        quality.oversampling = static_cast<EngineUtils::OversamplingFactor>(std::max(0, oversamplingSteps));
+        return quality;
+    }
+    
+    bool operator==(const RenderQuality& other) const
+    {
+        return oversampling == other.oversampling
+            && oversamplingFilter == other.oversamplingFilter
+            && controlBlockSize == other.controlBlockSize;
+    }
+    
+    bool operator!=(const RenderQuality& other) const { return !(*this == other); }
+};
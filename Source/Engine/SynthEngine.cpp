@@ -1,309 +1,1047 @@
-/*
-  ==============================================================================
-
-    SynthEngine.cpp
-    Created: 19 May 2025 3:28:44pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#include "SynthEngine.h"
-#include "../SynthesiserSound.h"
-#include "../Voice/VoiceWrapper.h"
-#include <JuceHeader.h>
-
-SynthEngine::SynthEngine()
-{
-    _requestedPlayMode = EngineUtils::PlayMode::Polyphonic;
-    setPlayMode(EngineUtils::PlayMode::Polyphonic);
-    setPitchRange(2.0f);
-}
-
-void SynthEngine::prepareToPlay(double sampleRate, int samplesPerBlock)
-{
-    setSampleRate(sampleRate);
-    
-    for (auto i = 0; i < _numVoices; ++i)
-    {
-        _voicePool[i].prepareToPlay(sampleRate, samplesPerBlock, _numChannels);
-        _voicePool[i].setPitchBendRange(_pitchBendRange);
-    }
-}
-
-void SynthEngine::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer)
-{
-    buffer.clear();
-    handleDeferredPlayModeChange();
-    handleMidi(midiBuffer);
-    renderVoices(buffer, 0, buffer.getNumSamples());
-}
-
-void SynthEngine::setPitchRange(float semitones)
-{
-    _pitchBendRange = semitones;
-    for (auto i = 0; i < _numVoices; ++i)
-    {
-        _voicePool[i].setPitchBendRange(semitones);
-    }
-}
-
-void SynthEngine::requestPlayModeChange(EngineUtils::PlayMode mode)
-{
-    _requestedPlayMode = mode;
-    _playModeChangeRequested.store(true, std::memory_order_release);
-}
-
-void SynthEngine::handleDeferredPlayModeChange()
-{
-    if (_playModeChangeRequested.exchange(false, std::memory_order_acquire))
-    {
-        setPlayMode(_requestedPlayMode);
-    }
-}
-
-void SynthEngine::setPlayMode(EngineUtils::PlayMode mode)
-{
-    switch (mode)
-    {
-        case EngineUtils::PlayMode::Monophonic:
-            _numVoices = 1;
-            break;
-        case EngineUtils::PlayMode::Duophonic:
-            // TODO: DEFINE THIS PLAY MODE
-            _numVoices = 2;
-            break;
-        case EngineUtils::PlayMode::Polyphonic:
-            _numVoices = _maxVoices;
-            break;
-        default:
-            _numVoices = 0;
-            break;
-    }
-    
-    _playMode = mode;
-    for (auto i = _numVoices; i < _maxVoices; ++i)
-    {
-        _voicePool[i].stopNote(0.0f, false);
-    }
-    
-    _activeNotes.clear();
-}
-
-void SynthEngine::handleMidi(const juce::MidiBuffer &midiBuffer)
-{
-    for (const auto metadata : midiBuffer)
-    {
-        const auto msg = metadata.getMessage();
-        //const auto time = metadata.samplePosition;
-        
-        if (msg.isNoteOn() && msg.getVelocity() > 0.0f)
-        {
-            const int midiNote = msg.getNoteNumber();
-            const float velocity = msg.getVelocity();
-            
-            // Note is already being played
-            if (_activeNotes.find(midiNote) != _activeNotes.end()) {
-                continue;
-            }
-            
-            // Get next free voice or steal one
-            for (auto i = 0; i < _numVoices; ++i)
-            {
-                if (!_voicePool[i].isVoiceActive())
-                {
-                    // TODO: Take current pitch wheel position into account
-                    _voicePool[i].startNote(midiNote, velocity, nullptr, _pitchWheelValue);
-                    _activeNotes.insert({midiNote, i});
-                    break;
-                }
-            }
-        }
-        else if (msg.isNoteOff() || (msg.isNoteOn() && msg.getVelocity() == 0.0f))
-        {
-            const int midiNote = msg.getNoteNumber();
-            for (auto i = 0; i < _numVoices; ++i)
-            {
-                if (_voicePool[i].isVoiceActive() && _voicePool[i].getCurrentlyPlayingNote() == midiNote)
-                {
-                    _voicePool[i].stopNote(0.0f, true);
-                    auto it = _activeNotes.find(midiNote);
-                    if (it != _activeNotes.end())
-                    {
-                        _activeNotes.erase(it);
-                    }
-                    
-                    break;
-                }
-            }
-        }
-        else if (msg.isPitchWheel())
-        {
-            const int pitchWheelValue = msg.getPitchWheelValue();
-            for (auto i = 0; i < _numVoices; ++i)
-            {
-                _voicePool[i].pitchWheelMoved(pitchWheelValue);
-            }
-        }
-    }
-}
-
-void SynthEngine::renderVoices(juce::AudioBuffer<float> &buffer, int startSample, int numSamples)
-{
-    // Get number of channels and initialise the temp buffer
-    const auto numChannels = buffer.getNumChannels();
-    juce::AudioBuffer<float> tempBuffer(numChannels, numSamples);
-    tempBuffer.clear();
-    
-    // Get number of acrive voices
-    int activeVoices = 0;
-    for (auto i = 0; i < _numVoices; ++i)
-    {
-        if (_voicePool[i].isVoiceActive())
-        {
-            _voicePool[i].renderNextBlock(tempBuffer, startSample, numSamples);
-            ++activeVoices;
-        }
-    }
-    
-    // Apply master gain
-    for (int sample = 0; sample < numSamples; ++sample)
-    {
-        const float gain = _masterGain.getNextSample();
-        for (int channel = 0; channel < numChannels; ++channel)
-        {
-            float* channelData = tempBuffer.getWritePointer(channel, startSample);
-            channelData[sample] *= gain;
-        }
-    }
-    
-    // Calculate & apply voice-count-based gain normalization to create headroom
-    auto gainNormalization = 1.0f;
-    if (activeVoices > 0)
-    {
-        gainNormalization = _gainCeiling / std::sqrtf(static_cast<float>(activeVoices));
-        gainNormalization = std::clamp(gainNormalization, 0.0f, 1.0f);
-    }
-    
-    tempBuffer.applyGain(gainNormalization);
-    for (auto channel = 0; channel < numChannels; ++channel)
-    {
-        buffer.addFrom(channel, startSample, tempBuffer, channel, startSample, numSamples);
-    }
-}
-
-void SynthEngine::reset()
-{
-    for (int i = 0; i < _maxVoices; ++i)
-    {
-        _voicePool[i].stopNote(0.0f, false);  // immediately stop all voices
-    }
-
-    _pitchWheelValue = 0.0f;
-    _playModeChangeRequested.store(false, std::memory_order_release);
-    _requestedPlayMode = _playMode;
-    _activeNotes.clear();
-}
-
-OscillatorUtils::WaveType SynthEngine::getOscillatorAType() const { return _voicePool[0].getOscillatorAType(); }
-OscillatorUtils::WaveType SynthEngine::getOscillatorBType() const { return _voicePool[0].getOscillatorBType(); }
-OscillatorUtils::WaveType SynthEngine::getOscillatorSubType() const { return _voicePool[0].getOscillatorSubType(); }
-
-void SynthEngine::setOscillatorAType(OscillatorUtils::WaveType type)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setOscillatorAType(type);
-    }
-}
-
-void SynthEngine::setOscillatorBType(OscillatorUtils::WaveType type)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setOscillatorBType(type);
-    }
-}
-
-void SynthEngine::setOscillatorSubType(OscillatorUtils::WaveType type)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setOscillatorSubType(type);
-    }
-}
-
-const juce::ADSR::Parameters SynthEngine::getAmplitudeEnvelopeParams() const { return _voicePool[0].getAmplitudeEnvelopeParams(); }
-const juce::ADSR::Parameters SynthEngine::getModulationEnvelopeParams() const { return _voicePool[0].getModulationEnvelopeParams(); }
-
-void SynthEngine::setEnvelopeParameters(const juce::ADSR::Parameters& amplitudeEnvelopeParams, const juce::ADSR::Parameters& modulationEnvelopeParams)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setAmplitudeEnvelopeParams(amplitudeEnvelopeParams);
-        voice.setModulationEnvelopeParams(modulationEnvelopeParams);
-    }
-}
-
-void SynthEngine::setAmplitudeEnvelopeParams(const juce::ADSR::Parameters& params)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setAmplitudeEnvelopeParams(params);
-    }
-}
-
-void SynthEngine::setModulationEnvelopeParams(const juce::ADSR::Parameters& params)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setModulationEnvelopeParams(params);
-    }
-}
-
-void SynthEngine::setOscillatorAGain(float gain)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setOscillatorAGain(gain, _gainRampTimeSeconds);
-    }
-}
-
-void SynthEngine::setOscillatorBGain(float gain)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setOscillatorBGain(gain, _gainRampTimeSeconds);
-    }
-}
-
-void SynthEngine::setOscillatorSubGain(float gain)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setOscillatorSubGain(gain, _gainRampTimeSeconds);
-    }
-}
-
-void SynthEngine::setOscillatorGains(float gainA, float gainB, float gainSub)
-{
-    for (auto& voice : _voicePool)
-    {
-        voice.setOscillatorGains(gainA, gainB, gainSub, _gainRampTimeSeconds);
-    }
-}
-
-void SynthEngine::setMasterGain(float gain)
-{
-    _masterGain.setTargetGain(gain, _gainRampTimeSeconds, _sampleRate);
-}
-
-float SynthEngine::getMasterGain() const
-{
-    return _masterGain.getTargetGain();
-}
-
-void SynthEngine::setSampleRate(double sampleRate)
-{
-    _sampleRate = sampleRate;
-}
+/*
+  ==============================================================================
+
+    SynthEngine.cpp
+    Created: 19 May 2025 3:28:44pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "SynthEngine.h"
+#include "../SynthesiserSound.h"
+#include "../Voice/VoiceWrapper.h"
+#include <JuceHeader.h>
+
+SynthEngine::SynthEngine()
+    : SynthEngine(std::make_shared<SharedTuning>())
+{
+}
+
+SynthEngine::SynthEngine(std::shared_ptr<SharedTuning> tuning)
+    : _sharedTuning(std::move(tuning)),
+      _activeTuning(&_sharedTuning->getActiveTuning())
+{
+    for (auto i = 0; i < _maxVoices; ++i)
+    {
+        _voicePool[i].setTuning(_activeTuning);
+    }
+    
+    clearActiveNotes();
+    _mpeZones.setLowerZone(_numMidiChannels - 1);
+    _requestedPlayMode = EngineUtils::PlayMode::Polyphonic;
+    setPlayMode(EngineUtils::PlayMode::Polyphonic);
+}
+
+void SynthEngine::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    setSampleRate(sampleRate);
+    _samplesPerBlock = std::max(1, samplesPerBlock);
+    _pitchBendFactor.reset(sampleRate, _pitchBendSmoothingSeconds);
+    
+    // Allocate the voice mix buffer and every oversampling stage up front so processBlock never has to
+    _voiceBuffer.setSize(_numChannels, _samplesPerBlock);
+    _oversampler.prepare(_samplesPerBlock, _numChannels);
+    _renderQuality = getRenderQuality();
+    _oversampler.setFactor(_renderQuality.oversampling, _renderQuality.oversamplingFilter);
+    
+    // Prepare the whole pool, not just the current play mode's voices, so switching modes later is safe
+    const auto voiceSampleRate = sampleRate * _oversampler.getFactor();
+    for (auto i = 0; i < _maxVoices; ++i)
+    {
+        _voicePool[i].prepareToPlay(voiceSampleRate, samplesPerBlock, _numChannels);
+        _voicePool[i].setControlBlockSize(_renderQuality.controlBlockSize);
+        _voicePool[i].setDriveInputLevel(_voiceHeadroom);
+    }
+}
+
+void SynthEngine::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer)
+{
+    // Flush denormals to zero (FTZ/DAZ) for the whole block, restored on exit
+    juce::ScopedNoDenormals noDenormals;
+    
+    buffer.clear();
+    handleDeferredPlayModeChange();
+    handleDeferredTuningChange();
+    updateRenderQuality();
+    handleMidi(midiBuffer);
+    if (_loadReduction > 0)
+    {
+        stealQuietReleasingVoices();
+    }
+    
+    _pitchBendFactor.setTargetValue(_activeTuning->getPitchBendFactor(_pitchWheelPosition));
+    
+    // Idle fast path: leave the buffer flagged as cleared so the wrapper can report silence
+    _isSilent = !hasActiveVoices() && !_masterGain.isRamping();
+    if (_isSilent)
+    {
+        // No voice to glide, so the next note starts straight at the current wheel position
+        _pitchBendFactor.setCurrentAndTargetValue(_pitchBendFactor.getTargetValue());
+        return;
+    }
+    
+    // The mix buffer and oversampling stages hold one prepared block, longer host blocks are rendered in chunks of that size
+    const auto numSamples = buffer.getNumSamples();
+    for (auto startSample = 0; startSample < numSamples; startSample += _samplesPerBlock)
+    {
+        renderVoices(buffer, startSample, std::min(_samplesPerBlock, numSamples - startSample));
+    }
+    
+    jassert(isNoteBookkeepingConsistent());
+    jassert(isOutputValid(buffer));
+}
+
+void SynthEngine::setPitchRange(float semitones)
+{
+    _sharedTuning->setPitchBendRange(semitones);
+}
+
+void SynthEngine::setTuning(const TuningTable& tuning)
+{
+    _sharedTuning->setTuning(tuning);
+}
+
+const TuningTable& SynthEngine::getTuning() const
+{
+    return _sharedTuning->getTuning();
+}
+
+void SynthEngine::handleDeferredTuningChange()
+{
+    const auto* tuning = &_sharedTuning->update();
+    if (tuning == _activeTuning)
+        return;
+    
+    _activeTuning = tuning;
+    for (auto i = 0; i < _maxVoices; ++i)
+    {
+        _voicePool[i].setTuning(tuning);
+    }
+}
+
+void SynthEngine::setOversampling(EngineUtils::OversamplingFactor realtime, EngineUtils::OversamplingFactor offline)
+{
+    _realtimeOversampling.store(realtime);
+    _offlineOversampling.store(offline);
+}
+
+void SynthEngine::setNonRealtime(bool isNonRealtime)
+{
+    _isNonRealtime.store(isNonRealtime);
+}
+
+RenderQuality SynthEngine::getRenderQuality() const
+{
+    return _isNonRealtime.load() ? RenderQuality::offline(_offlineOversampling.load())
+                                 : RenderQuality::realtime(_realtimeOversampling.load());
+}
+
+int SynthEngine::getLatencySamples() const
+{
+    const auto quality = getRenderQuality();
+    return _oversampler.getLatencySamples(quality.oversampling, quality.oversamplingFilter);
+}
+
+int SynthEngine::getOversamplingFactor() const
+{
+    return _oversampler.getFactor();
+}
+
+void SynthEngine::setLoadReduction(int level)
+{
+    _loadReduction = std::clamp(level, 0, maxLoadReduction);
+}
+
+void SynthEngine::updateRenderQuality()
+{
+    const auto quality = getRenderQuality().reducedBy(_loadReduction);
+    if (quality == _renderQuality)
+        return;
+    
+    _renderQuality = quality;
+    const auto previousFactor = _oversampler.getFactor();
+    _oversampler.setFactor(quality.oversampling, quality.oversamplingFilter);
+    
+    // Sounding voices carry on at the new rate with their gains and envelopes where they were
+    const auto rateChanged = _oversampler.getFactor() != previousFactor;
+    for (auto i = 0; i < _maxVoices; ++i)
+    {
+        if (rateChanged)
+        {
+            _voicePool[i].setSampleRate(_sampleRate * _oversampler.getFactor());
+        }
+        
+        _voicePool[i].setControlBlockSize(quality.controlBlockSize);
+    }
+}
+
+// Under load, voices already fading out below the level's threshold are faded out quickly rather than rendered to the end
+void SynthEngine::stealQuietReleasingVoices()
+{
+    const auto threshold = _stealThresholds[static_cast<size_t>(_loadReduction)];
+    for (auto i = 0; i < _numVoices; ++i)
+    {
+        auto& voice = _voicePool[i];
+        if (voice.isReleasing() && voice.getAmplitudeEnvelopeValue() < threshold)
+        {
+            voice.fadeOut();
+        }
+    }
+}
+
+void SynthEngine::requestPlayModeChange(EngineUtils::PlayMode mode)
+{
+    _requestedPlayMode.store(mode, std::memory_order_relaxed);
+    _playModeChangeRequested.store(true, std::memory_order_release);
+}
+
+void SynthEngine::handleDeferredPlayModeChange()
+{
+    if (_playModeChangeRequested.exchange(false, std::memory_order_acquire))
+    {
+        setPlayMode(_requestedPlayMode.load(std::memory_order_relaxed));
+    }
+}
+
+void SynthEngine::setPlayMode(EngineUtils::PlayMode mode)
+{
+    switch (mode)
+    {
+        case EngineUtils::PlayMode::Monophonic:
+            _numVoices = 1;
+            break;
+        case EngineUtils::PlayMode::Duophonic:
+            _numVoices = _maxMonophonicVoices;
+            break;
+        case EngineUtils::PlayMode::Polyphonic:
+            _numVoices = _maxVoices;
+            break;
+        default:
+            _numVoices = 0;
+            break;
+    }
+    
+    const auto wasPolyphonic = _playMode == EngineUtils::PlayMode::Polyphonic;
+    _playMode = mode;
+    
+    // Leaving poly mode, the stack is rebuilt from the keys still gated on a voice. Keys on voices
+    // about to be cut go in first, so with last-note priority the remaining voices keep their notes
+    if (wasPolyphonic && mode != EngineUtils::PlayMode::Polyphonic)
+    {
+        _heldNotes.clear();
+        for (const auto keepsVoice : { false, true })
+        {
+            for (auto key = 0; key < _numKeys; ++key)
+            {
+                const auto voiceIndex = _activeNotes[static_cast<size_t>(key)];
+                if (voiceIndex >= 0 && (voiceIndex < _numVoices) == keepsVoice)
+                {
+                    _heldNotes.push(key, _noteVelocities[static_cast<size_t>(key)]);
+                }
+            }
+        }
+    }
+    else if (mode == EngineUtils::PlayMode::Polyphonic)
+    {
+        _heldNotes.clear();
+    }
+    
+    for (auto i = _numVoices; i < _maxVoices; ++i)
+    {
+        _voicePool[i].stopNote(0.0f, false);
+    }
+    
+    // Keep the notes still held on the remaining voices so their note-offs land
+    for (auto& voiceIndex : _activeNotes)
+    {
+        if (voiceIndex >= _numVoices)
+        {
+            voiceIndex = -1;
+        }
+    }
+    
+    // Held keys that lost their voice get one back if they now have priority
+    if (mode != EngineUtils::PlayMode::Polyphonic)
+    {
+        updateMonophonicVoices();
+    }
+}
+
+void SynthEngine::handleMidi(const juce::MidiBuffer &midiBuffer)
+{
+    const auto isPolyphonic = _playMode == EngineUtils::PlayMode::Polyphonic;
+    updateMpeState();
+    
+    for (const auto metadata : midiBuffer)
+    {
+        const auto msg = metadata.getMessage();
+        //const auto time = metadata.samplePosition;
+        
+        if (_isMpeActive)
+        {
+            // Follows the controller's MPE configuration messages
+            _mpeZones.processNextMidiEvent(msg);
+        }
+        
+        if (msg.isNoteOn() && msg.getVelocity() > 0.0f)
+        {
+            const int key = getKey(msg);
+            const float velocity = msg.getVelocity();
+            
+            // The tuning leaves this key silent
+            if (!_activeTuning->isNoteMapped(msg.getNoteNumber()))
+                continue;
+            
+            _noteVelocities[static_cast<size_t>(key)] = velocity;
+            const auto retriggered = retriggerPedalHeldVoice(key, velocity);
+            if (isPolyphonic)
+            {
+                if (!retriggered)
+                {
+                    startPolyphonicNote(key, velocity);
+                }
+            }
+            else
+            {
+                _heldNotes.push(key, velocity);
+                updateMonophonicVoices();
+            }
+        }
+        else if (msg.isNoteOff() || (msg.isNoteOn() && msg.getVelocity() == 0.0f))
+        {
+            const int key = getKey(msg);
+            if (isHeldByPedal(key))
+            {
+                deferRelease(key);
+            }
+            else if (isPolyphonic)
+            {
+                releasePolyphonicNote(key);
+            }
+            else
+            {
+                _heldNotes.remove(key);
+                updateMonophonicVoices();
+            }
+        }
+        else if (handleMpeExpression(msg))
+        {
+            // Member channel expression, already routed to the voices on that channel
+        }
+        else if (msg.isController())
+        {
+            handleController(msg);
+        }
+        else if (msg.isPitchWheel())
+        {
+            // Only the last position in the block matters, voices pick it up through the bend ramp
+            _pitchWheelPosition = msg.getPitchWheelValue();
+        }
+    }
+}
+
+void SynthEngine::startPolyphonicNote(int key, float velocity)
+{
+    // Key is already being played, or the part is out of voices
+    if (findVoiceForKey(key) >= 0 || getNumActiveVoices() >= _voiceLimit)
+        return;
+    
+    // Get next free voice or steal one
+    for (auto i = 0; i < _numVoices; ++i)
+    {
+        if (!_voicePool[i].isVoiceActive())
+        {
+            _voicePool[i].setPitchBendFactor(_pitchBendFactor.getCurrentValue());
+            _voicePool[i].startNote(getNoteForKey(key), velocity, nullptr, _pitchWheelPosition);
+            _voicePool[i].setKeyDown(true);
+            _voicePool[i].setSostenutoPedalDown(false);
+            assignKey(i, key);
+            applyChannelExpression(i);
+            break;
+        }
+    }
+}
+
+void SynthEngine::releasePolyphonicNote(int key)
+{
+    // Release the voice holding this key, not one still tailing off from an earlier strike
+    const int voiceIndex = findVoiceForKey(key);
+    if (voiceIndex >= 0)
+    {
+        _voicePool[voiceIndex].stopNote(0.0f, true);
+    }
+    
+    _activeNotes[static_cast<size_t>(key)] = -1;
+}
+
+// Hands the mono/duo voices to the highest priority held keys. A voice moving from one held
+// key to another glides and, with legato on, keeps its envelopes running.
+void SynthEngine::updateMonophonicVoices()
+{
+    std::array<int, _maxMonophonicVoices> wantedKeys;
+    const auto numVoices = std::min(_numVoices, _maxMonophonicVoices);
+    const auto numWanted = _heldNotes.getPriorityNotes(_notePriority.load(), wantedKeys.data(), numVoices);
+    
+    // Voices already gated on a wanted key keep it; _activeNotes only maps gated keys here
+    std::array<bool, _maxMonophonicVoices> isVoiceKept {};
+    std::array<bool, _maxMonophonicVoices> isNoteSounding {};
+    for (auto i = 0; i < numWanted; ++i)
+    {
+        const auto voiceIndex = findVoiceForKey(wantedKeys[static_cast<size_t>(i)]);
+        if (voiceIndex >= 0)
+        {
+            isVoiceKept[static_cast<size_t>(voiceIndex)] = true;
+            isNoteSounding[static_cast<size_t>(i)] = true;
+        }
+    }
+    
+    const auto legato = _legato.load();
+    const auto glideSeconds = _glideSeconds.load();
+    const auto constantRate = _glideMode.load() == EngineUtils::GlideMode::ConstantRate;
+    
+    for (auto i = 0; i < numWanted; ++i)
+    {
+        if (isNoteSounding[static_cast<size_t>(i)])
+            continue;
+        
+        // Prefer a voice that is still gated so the move is a legato transition
+        auto voiceIndex = -1;
+        for (auto v = 0; v < numVoices; ++v)
+        {
+            if (isVoiceKept[static_cast<size_t>(v)])
+                continue;
+            
+            const auto isGated = findVoiceForKey(_voiceKeys[static_cast<size_t>(v)]) == v;
+            if (voiceIndex < 0 || isGated)
+            {
+                voiceIndex = v;
+            }
+        }
+        
+        if (voiceIndex < 0)
+            break;
+        
+        const auto key = wantedKeys[static_cast<size_t>(i)];
+        auto& voice = _voicePool[voiceIndex];
+        const auto previousKey = _voiceKeys[static_cast<size_t>(voiceIndex)];
+        const auto wasGated = findVoiceForKey(previousKey) == voiceIndex;
+        const auto fromFrequency = voice.getNoteFrequency();
+        
+        if (wasGated)
+        {
+            _activeNotes[static_cast<size_t>(previousKey)] = -1;
+        }
+        
+        voice.setPitchBendFactor(_pitchBendFactor.getCurrentValue());
+        if (wasGated && legato)
+        {
+            voice.changeNote(getNoteForKey(key));
+        }
+        else
+        {
+            voice.startNote(getNoteForKey(key), _heldNotes.getVelocity(key), nullptr, _pitchWheelPosition);
+        }
+        
+        voice.startGlide(fromFrequency, glideSeconds, constantRate);
+        voice.setKeyDown(!_isReleaseDeferred[static_cast<size_t>(key)]);
+        voice.setSostenutoPedalDown(false);
+        assignKey(voiceIndex, key);
+        applyChannelExpression(voiceIndex);
+        isVoiceKept[static_cast<size_t>(voiceIndex)] = true;
+    }
+    
+    // Voices left without a key release
+    for (auto v = 0; v < numVoices; ++v)
+    {
+        const auto key = _voiceKeys[static_cast<size_t>(v)];
+        if (!isVoiceKept[static_cast<size_t>(v)] && findVoiceForKey(key) == v)
+        {
+            _voicePool[v].stopNote(0.0f, true);
+            _activeNotes[static_cast<size_t>(key)] = -1;
+        }
+    }
+}
+
+void SynthEngine::handleController(const juce::MidiMessage& message)
+{
+    if (message.isSustainPedalOn() || message.isSustainPedalOff())
+    {
+        _sustainPedalDown = message.isSustainPedalOn();
+        if (!_sustainPedalDown)
+        {
+            releaseDeferredNotes();
+        }
+    }
+    else if (message.isSostenutoPedalOn() || message.isSostenutoPedalOff())
+    {
+        // Sostenuto only latches the keys that are down when it is pressed
+        _sostenutoPedalDown = message.isSostenutoPedalOn();
+        for (auto i = 0; i < _numVoices; ++i)
+        {
+            auto& voice = _voicePool[i];
+            voice.setSostenutoPedalDown(_sostenutoPedalDown && voice.isVoiceActive() && voice.isKeyDown());
+        }
+        
+        if (!_sostenutoPedalDown)
+        {
+            releaseDeferredNotes();
+        }
+    }
+    else
+    {
+        for (auto i = 0; i < _numVoices; ++i)
+        {
+            _voicePool[i].controllerMoved(message.getControllerNumber(), message.getControllerValue());
+        }
+    }
+}
+
+bool SynthEngine::isHeldByPedal(int key) const
+{
+    if (_sustainPedalDown)
+        return true;
+    
+    const auto voiceIndex = findVoiceForKey(key);
+    return voiceIndex >= 0 && _voicePool[voiceIndex].isSostenutoPedalDown();
+}
+
+void SynthEngine::deferRelease(int key)
+{
+    if (!juce::isPositiveAndBelow(key, _numKeys))
+        return;
+    
+    const auto voiceIndex = findVoiceForKey(key);
+    if (voiceIndex >= 0)
+    {
+        _voicePool[voiceIndex].setKeyDown(false);
+    }
+    
+    auto& isDeferred = _isReleaseDeferred[static_cast<size_t>(key)];
+    if (!isDeferred)
+    {
+        // A key is parked at most once, so the list can't outgrow the key range
+        jassert(_numDeferredReleases < _numKeys);
+        isDeferred = true;
+        _deferredReleases[static_cast<size_t>(_numDeferredReleases)] = key;
+        ++_numDeferredReleases;
+    }
+}
+
+void SynthEngine::cancelDeferredRelease(int key)
+{
+    auto& isDeferred = _isReleaseDeferred[static_cast<size_t>(key)];
+    if (!isDeferred)
+        return;
+    
+    isDeferred = false;
+    const auto end = _deferredReleases.begin() + _numDeferredReleases;
+    if (std::remove(_deferredReleases.begin(), end, key) != end)
+    {
+        --_numDeferredReleases;
+    }
+}
+
+// Single pass over the parked keys, keeping those another pedal still holds
+void SynthEngine::releaseDeferredNotes()
+{
+    const auto isPolyphonic = _playMode == EngineUtils::PlayMode::Polyphonic;
+    auto numStillHeld = 0;
+    
+    for (auto i = 0; i < _numDeferredReleases; ++i)
+    {
+        const auto key = _deferredReleases[static_cast<size_t>(i)];
+        if (isHeldByPedal(key))
+        {
+            _deferredReleases[static_cast<size_t>(numStillHeld)] = key;
+            ++numStillHeld;
+            continue;
+        }
+        
+        _isReleaseDeferred[static_cast<size_t>(key)] = false;
+        if (isPolyphonic)
+        {
+            releasePolyphonicNote(key);
+        }
+        else
+        {
+            _heldNotes.remove(key);
+        }
+    }
+    
+    _numDeferredReleases = numStillHeld;
+    if (!isPolyphonic)
+    {
+        updateMonophonicVoices();
+    }
+}
+
+// A key struck again while a pedal still holds its voice restarts that voice rather than taking another
+bool SynthEngine::retriggerPedalHeldVoice(int key, float velocity)
+{
+    if (!juce::isPositiveAndBelow(key, _numKeys))
+        return false;
+    
+    cancelDeferredRelease(key);
+    const auto voiceIndex = findVoiceForKey(key);
+    if (voiceIndex < 0 || _voicePool[voiceIndex].isKeyDown())
+        return false;
+    
+    auto& voice = _voicePool[voiceIndex];
+    voice.setPitchBendFactor(_pitchBendFactor.getCurrentValue());
+    voice.startNote(getNoteForKey(key), velocity, nullptr, _pitchWheelPosition);
+    voice.setKeyDown(true);
+    applyChannelExpression(voiceIndex);
+    return true;
+}
+
+void SynthEngine::updateMpeState()
+{
+    const auto enabled = _mpeEnabled.load();
+    if (enabled == _isMpeActive)
+        return;
+    
+    // Keys are numbered per channel under MPE, so held keys are released rather than carried
+    // over with the wrong numbers. Sounding voices ease back to neutral expression
+    for (auto i = 0; i < _numVoices; ++i)
+    {
+        if (findVoiceForKey(_voiceKeys[static_cast<size_t>(i)]) == i)
+        {
+            _voicePool[i].stopNote(0.0f, true);
+        }
+    }
+    
+    clearActiveNotes();
+    _heldNotes.clear();
+    _isReleaseDeferred.fill(false);
+    _numDeferredReleases = 0;
+    
+    _isMpeActive = enabled;
+    _channelExpression.fill({});
+    for (auto i = 0; i < _maxVoices; ++i)
+    {
+        _voicePool[i].setExpression(0.0f, 1.0f, 0.5f, false);
+    }
+}
+
+// Per-note pitch bend, channel pressure and CC74 on an MPE member channel. Each message only
+// updates the channel state and the smoothing targets of its voices, the voices do the rest at control rate.
+// Master channel messages fall through and apply to every voice
+bool SynthEngine::handleMpeExpression(const juce::MidiMessage& message)
+{
+    const auto channel = message.getChannel();
+    if (!_isMpeActive || !isMpeMemberChannel(channel))
+        return false;
+    
+    auto& expression = _channelExpression[static_cast<size_t>(channel - 1)];
+    if (message.isPitchWheel())
+    {
+        const auto normalizedOffset = std::clamp((message.getPitchWheelValue() - TuningTable::pitchWheelCentre) / static_cast<float>(TuningTable::pitchWheelCentre), -1.0f, 1.0f);
+        expression.pitchBendSemitones = normalizedOffset * _mpePitchBendRange.load();
+    }
+    else if (message.isChannelPressure())
+    {
+        expression.pressure = message.getChannelPressureValue() / 127.0f;
+    }
+    else if (message.isController() && message.getControllerNumber() == _timbreController)
+    {
+        expression.timbre = message.getControllerValue() / 127.0f;
+    }
+    else
+    {
+        return false;
+    }
+    
+    for (auto i = 0; i < _numVoices; ++i)
+    {
+        if (getChannelForKey(_voiceKeys[static_cast<size_t>(i)]) == channel && _voicePool[i].isVoiceActive())
+        {
+            _voicePool[i].setExpression(expression.pitchBendSemitones, expression.pressure, expression.timbre, false);
+        }
+    }
+    
+    return true;
+}
+
+// A voice starting or changing note picks up its channel's current expression without smoothing
+void SynthEngine::applyChannelExpression(int voiceIndex)
+{
+    auto& voice = _voicePool[voiceIndex];
+    const auto channel = getChannelForKey(_voiceKeys[static_cast<size_t>(voiceIndex)]);
+    if (!_isMpeActive || !isMpeMemberChannel(channel))
+    {
+        voice.setExpression(0.0f, 1.0f, 0.5f, true);
+        return;
+    }
+    
+    const auto& expression = _channelExpression[static_cast<size_t>(channel - 1)];
+    voice.setExpression(expression.pitchBendSemitones, expression.pressure, expression.timbre, true);
+}
+
+bool SynthEngine::isMpeMemberChannel(int channel) const
+{
+    return _mpeZones.getLowerZone().isUsingChannelAsMemberChannel(channel) || _mpeZones.getUpperZone().isUsingChannelAsMemberChannel(channel);
+}
+
+void SynthEngine::setMpeEnabled(bool enabled)
+{
+    _mpeEnabled.store(enabled);
+}
+
+void SynthEngine::setMpePitchBendRange(float semitones)
+{
+    _mpePitchBendRange.store(std::clamp(semitones, 0.0f, 96.0f));
+}
+
+void SynthEngine::setNotePriority(EngineUtils::NotePriority priority)
+{
+    _notePriority.store(priority);
+}
+
+void SynthEngine::setLegato(bool legato)
+{
+    _legato.store(legato);
+}
+
+void SynthEngine::setGlide(float glideSeconds, EngineUtils::GlideMode mode)
+{
+    _glideSeconds.store(std::max(0.0f, glideSeconds));
+    _glideMode.store(mode);
+}
+
+void SynthEngine::setVoiceDrive(float amount, EngineUtils::SaturationShape shape)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setDrive(amount, shape);
+    }
+}
+
+void SynthEngine::setSampleStreamer(SampleStreamer* streamer)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setSampleStreamer(streamer);
+    }
+}
+
+void SynthEngine::renderVoices(juce::AudioBuffer<float> &buffer, int startSample, int numSamples)
+{
+    // Voices mix into the start of the temp buffer, numSamples never exceeds the prepared block size
+    jassert(numSamples <= _voiceBuffer.getNumSamples());
+    const auto numChannels = std::min(buffer.getNumChannels(), _numChannels);
+    juce::AudioBuffer<float> tempBuffer(_voiceBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+    tempBuffer.clear();
+    
+    if (_oversampler.isEnabled())
+    {
+        // Voices run at the oversampled rate and are decimated back into the mix buffer
+        auto oversampledBlock = _oversampler.beginRender(tempBuffer, 0, numSamples);
+        std::array<float*, _numChannels> channels {};
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            channels[static_cast<size_t>(channel)] = oversampledBlock.getChannelPointer(static_cast<size_t>(channel));
+        }
+        
+        juce::AudioBuffer<float> oversampledBuffer(channels.data(), numChannels, static_cast<int>(oversampledBlock.getNumSamples()));
+        renderVoiceSubBlocks(oversampledBuffer, 0, numSamples, _oversampler.getFactor());
+        _oversampler.endRender(tempBuffer, 0, numSamples);
+    }
+    else
+    {
+        renderVoiceSubBlocks(tempBuffer, 0, numSamples, 1);
+    }
+    
+    // Apply master gain, per sample only while it is ramping
+    auto masterGain = 1.0f;
+    if (_masterGain.isRamping())
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            const float gain = _masterGain.getNextSample();
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                float* channelData = tempBuffer.getWritePointer(channel);
+                channelData[sample] *= gain;
+            }
+        }
+    }
+    else
+    {
+        masterGain = _masterGain.getNextSample();
+    }
+    
+    // Fixed headroom per voice, the master limiter keeps dense chords and parts in range
+    for (auto channel = 0; channel < numChannels; ++channel)
+    {
+        buffer.addFrom(channel, startSample, tempBuffer, channel, 0, numSamples, masterGain * _voiceHeadroom);
+    }
+}
+
+// numSamples is at the host rate, the target holds oversamplingFactor samples for each of them
+void SynthEngine::renderVoiceSubBlocks(juce::AudioBuffer<float>& target, int targetStartSample, int numSamples, int oversamplingFactor)
+{
+    // One bend factor is shared by all voices. While it glides, voices are retuned per sub-block
+    const auto subBlockSize = _pitchBendFactor.isSmoothing() ? _renderQuality.controlBlockSize : numSamples;
+    for (auto offset = 0; offset < numSamples; offset += subBlockSize)
+    {
+        const auto subBlockLength = std::min(subBlockSize, numSamples - offset);
+        const auto pitchBendFactor = _pitchBendFactor.isSmoothing() ? _pitchBendFactor.skip(subBlockLength) : _pitchBendFactor.getTargetValue();
+        
+        for (auto i = 0; i < _numVoices; ++i)
+        {
+            if (_voicePool[i].isVoiceActive())
+            {
+                _voicePool[i].setPitchBendFactor(pitchBendFactor);
+                _voicePool[i].renderNextBlock(target, targetStartSample + offset * oversamplingFactor, subBlockLength * oversamplingFactor);
+            }
+        }
+    }
+}
+
+void SynthEngine::reset()
+{
+    for (int i = 0; i < _maxVoices; ++i)
+    {
+        _voicePool[i].stopNote(0.0f, false);  // immediately stop all voices
+    }
+
+    _pitchWheelPosition = TuningTable::pitchWheelCentre;
+    _pitchBendFactor.setCurrentAndTargetValue(1.0f);
+    _heldNotes.clear();
+    _sustainPedalDown = false;
+    _sostenutoPedalDown = false;
+    _isReleaseDeferred.fill(false);
+    _numDeferredReleases = 0;
+    _channelExpression.fill({});
+    _oversampler.reset();
+    _playModeChangeRequested.store(false, std::memory_order_release);
+    _requestedPlayMode.store(_playMode, std::memory_order_relaxed);
+    clearActiveNotes();
+}
+
+bool SynthEngine::hasActiveVoices() const
+{
+    for (auto i = 0; i < _numVoices; ++i)
+    {
+        if (_voicePool[i].isVoiceActive())
+            return true;
+    }
+    
+    return false;
+}
+
+void SynthEngine::setVoiceLimit(int voices)
+{
+    _voiceLimit = std::clamp(voices, 0, _maxVoices);
+}
+
+int SynthEngine::getNumActiveVoices() const
+{
+    auto activeVoices = 0;
+    for (auto i = 0; i < _numVoices; ++i)
+    {
+        if (_voicePool[i].isVoiceActive())
+        {
+            ++activeVoices;
+        }
+    }
+    
+    return activeVoices;
+}
+
+bool SynthEngine::isSilent() const
+{
+    return _isSilent;
+}
+
+// The longest a voice keeps sounding after its note-off
+double SynthEngine::getTailLengthSeconds() const
+{
+    return static_cast<double>(_amplitudeReleaseSeconds.load(std::memory_order_relaxed) + _gainRampTimeSeconds);
+}
+
+void SynthEngine::clearActiveNotes()
+{
+    _activeNotes.fill(-1);
+    _voiceKeys.fill(-1);
+}
+
+// Returns the voice holding the given key, or -1 if the key isn't held. Voices
+// that finished on their own (e.g. zero sustain) or were reused don't count.
+int SynthEngine::findVoiceForKey(int key) const
+{
+    if (!juce::isPositiveAndBelow(key, _numKeys))
+        return -1;
+    
+    const int voiceIndex = _activeNotes[static_cast<size_t>(key)];
+    if (voiceIndex < 0 || voiceIndex >= _numVoices)
+        return -1;
+    
+    return (_voicePool[voiceIndex].isVoiceActive() && _voiceKeys[static_cast<size_t>(voiceIndex)] == key) ? voiceIndex : -1;
+}
+
+void SynthEngine::assignKey(int voiceIndex, int key)
+{
+    _activeNotes[static_cast<size_t>(key)] = voiceIndex;
+    _voiceKeys[static_cast<size_t>(voiceIndex)] = key;
+}
+
+// Under MPE the same note on two member channels is two keys, each with its own voice
+int SynthEngine::getKey(const juce::MidiMessage& message) const
+{
+    const auto channelOffset = _isMpeActive ? (message.getChannel() - 1) * _numMidiNotes : 0;
+    return channelOffset + message.getNoteNumber();
+}
+
+int SynthEngine::getNoteForKey(int key)
+{
+    return key % _numMidiNotes;
+}
+
+int SynthEngine::getChannelForKey(int key)
+{
+    return key >= 0 ? key / _numMidiNotes + 1 : 0;
+}
+
+bool SynthEngine::isNoteBookkeepingConsistent() const
+{
+    // Held keys may only point into the current pool...
+    for (const auto voiceIndex : _activeNotes)
+    {
+        if (voiceIndex < -1 || voiceIndex >= _numVoices)
+            return false;
+    }
+    
+    // ...voices outside of it must have been silenced by the play mode change...
+    for (auto i = _numVoices; i < _maxVoices; ++i)
+    {
+        if (_voicePool[i].isVoiceActive())
+            return false;
+    }
+    
+    // ...and each key parked by a pedal is listed exactly once
+    const auto numParked = std::count(_isReleaseDeferred.begin(), _isReleaseDeferred.end(), true);
+    return numParked == _numDeferredReleases;
+}
+
+bool SynthEngine::isOutputValid(const juce::AudioBuffer<float>& buffer)
+{
+    for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        const auto* channelData = buffer.getReadPointer(channel);
+        for (auto sample = 0; sample < buffer.getNumSamples(); ++sample)
+        {
+            const auto value = channelData[sample];
+            if (!std::isfinite(value) || (value != 0.0f && std::fpclassify(value) == FP_SUBNORMAL))
+                return false;
+        }
+    }
+    
+    return true;
+}
+
+OscillatorUtils::WaveType SynthEngine::getOscillatorAType() const { return _voicePool[0].getOscillatorAType(); }
+OscillatorUtils::WaveType SynthEngine::getOscillatorBType() const { return _voicePool[0].getOscillatorBType(); }
+OscillatorUtils::WaveType SynthEngine::getOscillatorSubType() const { return _voicePool[0].getOscillatorSubType(); }
+
+void SynthEngine::setOscillatorAType(OscillatorUtils::WaveType type)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setOscillatorAType(type);
+    }
+}
+
+void SynthEngine::setOscillatorBType(OscillatorUtils::WaveType type)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setOscillatorBType(type);
+    }
+}
+
+void SynthEngine::setOscillatorSubType(OscillatorUtils::WaveType type)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setOscillatorSubType(type);
+    }
+}
+
+const juce::ADSR::Parameters SynthEngine::getAmplitudeEnvelopeParams() const { return _voicePool[0].getAmplitudeEnvelopeParams(); }
+const juce::ADSR::Parameters SynthEngine::getModulationEnvelopeParams() const { return _voicePool[0].getModulationEnvelopeParams(); }
+
+void SynthEngine::setEnvelopeParameters(const juce::ADSR::Parameters& amplitudeEnvelopeParams, const juce::ADSR::Parameters& modulationEnvelopeParams)
+{
+    _amplitudeReleaseSeconds.store(amplitudeEnvelopeParams.release, std::memory_order_relaxed);
+    for (auto& voice : _voicePool)
+    {
+        voice.setAmplitudeEnvelopeParams(amplitudeEnvelopeParams);
+        voice.setModulationEnvelopeParams(modulationEnvelopeParams);
+    }
+}
+
+void SynthEngine::setAmplitudeEnvelopeParams(const juce::ADSR::Parameters& params)
+{
+    _amplitudeReleaseSeconds.store(params.release, std::memory_order_relaxed);
+    for (auto& voice : _voicePool)
+    {
+        voice.setAmplitudeEnvelopeParams(params);
+    }
+}
+
+void SynthEngine::setModulationEnvelopeParams(const juce::ADSR::Parameters& params)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setModulationEnvelopeParams(params);
+    }
+}
+
+void SynthEngine::setOscillatorAGain(float gain)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setOscillatorAGain(gain, _gainRampTimeSeconds);
+    }
+}
+
+void SynthEngine::setOscillatorBGain(float gain)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setOscillatorBGain(gain, _gainRampTimeSeconds);
+    }
+}
+
+void SynthEngine::setOscillatorSubGain(float gain)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setOscillatorSubGain(gain, _gainRampTimeSeconds);
+    }
+}
+
+void SynthEngine::setOscillatorGains(float gainA, float gainB, float gainSub)
+{
+    for (auto& voice : _voicePool)
+    {
+        voice.setOscillatorGains(gainA, gainB, gainSub, _gainRampTimeSeconds);
+    }
+}
+
+void SynthEngine::setMasterGain(float gain)
+{
+    _masterGain.setTargetGain(gain, _gainRampTimeSeconds, _sampleRate);
+}
+
+float SynthEngine::getMasterGain() const
+{
+    return _masterGain.getTargetGain();
+}
+
+void SynthEngine::setSampleRate(double sampleRate)
+{
+    _sampleRate = sampleRate;
+}
@@ -1,78 +1,206 @@
-/*
-  ==============================================================================
-
-    SynthEngine.h
-    Created: 19 May 2025 3:28:44pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "../Utils/EngineUtils.h"
-#include "../Voice/VoiceWrapper.h"
-
-class SynthEngine {
-    public:
-    SynthEngine();
-    ~SynthEngine() = default;
-    
-    void prepareToPlay(double sampleRate, int samplesPerBlock);
-    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
-    
-    void setPitchRange(float semitones);
-    void requestPlayModeChange(EngineUtils::PlayMode mode);
-    void handleDeferredPlayModeChange();
-    void setPlayMode(EngineUtils::PlayMode mode);
-    void reset();
-    
-    // Oscillators
-    OscillatorUtils::WaveType getOscillatorAType() const;
-    OscillatorUtils::WaveType getOscillatorBType() const;
-    OscillatorUtils::WaveType getOscillatorSubType() const;
-    
-    void setOscillatorAType(OscillatorUtils::WaveType type);
-    void setOscillatorBType(OscillatorUtils::WaveType type);
-    void setOscillatorSubType(OscillatorUtils::WaveType type);
-    
-    void setOscillatorAGain(float gain);
-    void setOscillatorBGain(float gain);
-    void setOscillatorSubGain(float gain);
-    void setOscillatorGains(float gainA, float gainB, float gainSub);
-    
-    // Envelopes
-    const juce::ADSR::Parameters getAmplitudeEnvelopeParams() const;
-    const juce::ADSR::Parameters getModulationEnvelopeParams() const;
-    
-    void setAmplitudeEnvelopeParams(const juce::ADSR::Parameters& params);
-    void setModulationEnvelopeParams(const juce::ADSR::Parameters& params);
-    void setEnvelopeParameters(const juce::ADSR::Parameters& amplitudeEnvelopeParams, const juce::ADSR::Parameters& modulationEnvelopeParams);
-    
-    // Gain
-    void setMasterGain(float gain);
-    float getMasterGain() const;
-    
-private:
-    double _sampleRate = 44100.0;
-    static constexpr int _maxVoices = 8;
-    VoiceWrapper _voicePool[_maxVoices];
-    int _numVoices = 8;
-    std::unordered_map<int, int> _activeNotes; // key = midi note, value = voice pool index
-
-    float _pitchBendRange = 2.0f;
-    float _pitchWheelValue = 0.0f;
-    int _numChannels = 2;
-    Gain _masterGain;
-    static constexpr float _gainCeiling = 0.25f; // Gives roughly -12dB headroom
-    static constexpr float _gainRampTimeSeconds = 0.025f;
-    
-    EngineUtils::PlayMode _playMode = EngineUtils::PlayMode::Polyphonic;
-    EngineUtils::PlayMode _requestedPlayMode;
-    std::atomic<bool> _playModeChangeRequested = false;
-    
-    // Helpers
-    void renderVoices(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
-    void handleMidi(const juce::MidiBuffer& midiMessages);
-    void setSampleRate(double sampleRate);
-};
+/*
+  ==============================================================================
+
+    SynthEngine.h
+    Created: 19 May 2025 3:28:44pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utils/EngineUtils.h"
+#include "../Voice/VoiceWrapper.h"
+#include "../Tuning/SharedTuning.h"
+#include "../Oversampler/Oversampler.h"
+#include "RenderQuality.h"
+#include "NoteStack.h"
+
+class SynthEngine {
+    public:
+    static constexpr int maxLoadReduction = 3;
+    
+    SynthEngine();
+    explicit SynthEngine(std::shared_ptr<SharedTuning> tuning); // Engines built from one SharedTuning play the same tables
+    
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+    
+    void setPitchRange(float semitones);
+    
+    // Tuning, message thread only. The new table is swapped in at the start of the next block
+    void setTuning(const TuningTable& tuning);
+    const TuningTable& getTuning() const;
+    
+    // Caps the voices polyphonic notes may hold, set from the audio thread before processBlock
+    void setVoiceLimit(int voices);
+    int getNumActiveVoices() const;
+    
+    void requestPlayModeChange(EngineUtils::PlayMode mode);
+    void handleDeferredPlayModeChange();
+    void setPlayMode(EngineUtils::PlayMode mode);
+    
+    // Mono and duo modes
+    void setNotePriority(EngineUtils::NotePriority priority);
+    void setLegato(bool legato);
+    void setGlide(float glideSeconds, EngineUtils::GlideMode mode);
+    
+    // Per-voice saturation, amount 0 is off
+    void setVoiceDrive(float amount, EngineUtils::SaturationShape shape);
+    
+    // Source for oscillators set to Sample, owned by the caller. Set before playing
+    void setSampleStreamer(SampleStreamer* streamer);
+    
+    // Render quality. The offline profile is used while the host renders non-realtime,
+    // oversampling is chosen separately for each profile
+    void setOversampling(EngineUtils::OversamplingFactor realtime, EngineUtils::OversamplingFactor offline);
+    void setNonRealtime(bool isNonRealtime);
+    RenderQuality getRenderQuality() const;
+    int getLatencySamples() const;
+    int getOversamplingFactor() const; // The factor the last block rendered at
+    
+    // Set from the audio thread under CPU pressure, 0 is full quality. Higher levels render
+    // cheaper, with less oversampling from level 2, and fade quiet releasing voices out early
+    void setLoadReduction(int level);
+    
+    // MPE: zones follow the controller's MPE configuration messages, until one arrives channel 1
+    // is the master and 2-16 carry per-note expression. Notes are tracked per channel while enabled
+    void setMpeEnabled(bool enabled);
+    void setMpePitchBendRange(float semitones);
+    void reset();
+    
+    // Idle state
+    bool hasActiveVoices() const;
+    bool isSilent() const;
+    double getTailLengthSeconds() const;
+    
+    // Debug checks, also run after every block by the stress tests
+    bool isNoteBookkeepingConsistent() const;
+    static bool isOutputValid(const juce::AudioBuffer<float>& buffer);
+    
+    // Oscillators
+    OscillatorUtils::WaveType getOscillatorAType() const;
+    OscillatorUtils::WaveType getOscillatorBType() const;
+    OscillatorUtils::WaveType getOscillatorSubType() const;
+    
+    void setOscillatorAType(OscillatorUtils::WaveType type);
+    void setOscillatorBType(OscillatorUtils::WaveType type);
+    void setOscillatorSubType(OscillatorUtils::WaveType type);
+    
+    void setOscillatorAGain(float gain);
+    void setOscillatorBGain(float gain);
+    void setOscillatorSubGain(float gain);
+    void setOscillatorGains(float gainA, float gainB, float gainSub);
+    
+    // Envelopes
+    const juce::ADSR::Parameters getAmplitudeEnvelopeParams() const;
+    const juce::ADSR::Parameters getModulationEnvelopeParams() const;
+    
+    void setAmplitudeEnvelopeParams(const juce::ADSR::Parameters& params);
+    void setModulationEnvelopeParams(const juce::ADSR::Parameters& params);
+    void setEnvelopeParameters(const juce::ADSR::Parameters& amplitudeEnvelopeParams, const juce::ADSR::Parameters& modulationEnvelopeParams);
+    
+    // Gain
+    void setMasterGain(float gain);
+    float getMasterGain() const;
+    
+private:
+    double _sampleRate = 44100.0;
+    static constexpr int _maxVoices = 8;
+    VoiceWrapper _voicePool[_maxVoices];
+    int _numVoices = 8;
+    int _voiceLimit = _maxVoices;
+    static constexpr int _numMidiNotes = 128;
+    static constexpr int _numMidiChannels = 16;
+    static constexpr int _numKeys = _numMidiChannels * _numMidiNotes; // Under MPE a key is a note on one channel
+    std::array<int, _numKeys> _activeNotes; // index = key (midi note, plus 128 per channel under MPE), value = voice pool index or -1
+    std::array<int, _maxVoices> _voiceKeys; // Key each voice was last given
+
+    int _pitchWheelPosition = TuningTable::pitchWheelCentre; // Latest wheel message, coalesced per block
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> _pitchBendFactor = 1.0f;
+    static constexpr double _pitchBendSmoothingSeconds = 0.005;
+    
+    std::shared_ptr<SharedTuning> _sharedTuning;
+    const TuningTable* _activeTuning; // Audio thread, the table the voices currently point at
+    static constexpr int _numChannels = 2;
+    int _samplesPerBlock = 512;
+    juce::AudioBuffer<float> _voiceBuffer;
+    bool _isSilent = true;
+    std::atomic<float> _amplitudeReleaseSeconds = 0.1f; // Read by the host for the tail length
+    Gain _masterGain;
+    static constexpr float _voiceHeadroom = 0.25f; // -12dB, the level a lone voice always had, well clear of the limiter
+    static constexpr float _gainRampTimeSeconds = 0.025f;
+    
+    EngineUtils::PlayMode _playMode = EngineUtils::PlayMode::Polyphonic;
+    std::atomic<EngineUtils::PlayMode> _requestedPlayMode;
+    std::atomic<bool> _playModeChangeRequested = false;
+    
+    // Render quality. The audio thread switches to the wanted profile at the start of a block
+    RenderQuality _renderQuality; // Audio thread
+    int _loadReduction = 0;
+    static constexpr std::array<float, maxLoadReduction + 1> _stealThresholds { 0.0f, 0.004f, 0.016f, 0.063f }; // -48, -36 and -24dB
+    Oversampler _oversampler;
+    std::atomic<EngineUtils::OversamplingFactor> _realtimeOversampling = EngineUtils::OversamplingFactor::Off;
+    std::atomic<EngineUtils::OversamplingFactor> _offlineOversampling = EngineUtils::OversamplingFactor::Off;
+    std::atomic<bool> _isNonRealtime = false;
+    
+    // Mono and duo modes give their voices to the highest priority held keys
+    NoteStack _heldNotes;
+    std::array<float, _numKeys> _noteVelocities {}; // Latest strike per key, to rebuild the stack when leaving poly mode
+    static constexpr int _maxMonophonicVoices = 2;
+    std::atomic<EngineUtils::NotePriority> _notePriority = EngineUtils::NotePriority::Last;
+    std::atomic<bool> _legato = true;
+    std::atomic<float> _glideSeconds = 0.0f;
+    std::atomic<EngineUtils::GlideMode> _glideMode = EngineUtils::GlideMode::ConstantTime;
+    
+    // Pedals. Keys released while a pedal holds them are parked here and released in one pass on pedal up
+    bool _sustainPedalDown = false;
+    bool _sostenutoPedalDown = false;
+    std::array<int, _numKeys> _deferredReleases;
+    int _numDeferredReleases = 0;
+    std::array<bool, _numKeys> _isReleaseDeferred {};
+    
+    // MPE. Expression is kept per channel and handed to the voices playing on it as smoothing targets
+    struct ChannelExpression
+    {
+        float pitchBendSemitones = 0.0f;
+        float pressure = 1.0f; // Full level until the controller sends pressure
+        float timbre = 0.5f;
+    };
+    
+    static constexpr int _timbreController = 74;
+    std::atomic<bool> _mpeEnabled = false;
+    std::atomic<float> _mpePitchBendRange = 48.0f;
+    bool _isMpeActive = false; // Audio thread copy of _mpeEnabled, so a change can reset the voices
+    std::array<ChannelExpression, _numMidiChannels> _channelExpression;
+    juce::MPEZoneLayout _mpeZones; // Audio thread
+    
+    // Helpers
+    void renderVoices(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    void renderVoiceSubBlocks(juce::AudioBuffer<float>& target, int targetStartSample, int numSamples, int oversamplingFactor);
+    void updateRenderQuality();
+    void stealQuietReleasingVoices();
+    void handleMidi(const juce::MidiBuffer& midiMessages);
+    void startPolyphonicNote(int key, float velocity);
+    void releasePolyphonicNote(int key);
+    void updateMonophonicVoices();
+    void handleController(const juce::MidiMessage& message);
+    bool isHeldByPedal(int key) const;
+    void deferRelease(int key);
+    void cancelDeferredRelease(int key);
+    void releaseDeferredNotes();
+    bool retriggerPedalHeldVoice(int key, float velocity);
+    void updateMpeState();
+    bool handleMpeExpression(const juce::MidiMessage& message);
+    void applyChannelExpression(int voiceIndex);
+    bool isMpeMemberChannel(int channel) const;
+    void handleDeferredTuningChange();
+    void setSampleRate(double sampleRate);
+    void clearActiveNotes();
+    int findVoiceForKey(int key) const;
+    void assignKey(int voiceIndex, int key);
+    int getKey(const juce::MidiMessage& message) const;
+    static int getNoteForKey(int key);
+    static int getChannelForKey(int key);
+};
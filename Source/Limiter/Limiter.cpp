@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    Limiter.cpp
+    Created: 21 Oct 2026 1:18:36pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "Limiter.h"
+
+void Limiter::prepare(double sampleRate, int numChannels)
+{
+    jassert(numChannels <= _maxChannels);
+    _numChannels = std::clamp(numChannels, 1, _maxChannels);
+    _delayLine.setSize(_maxChannels, lookaheadSamples);
+    _attackCoefficient = static_cast<float>(std::exp(-1.0 / (_attackSeconds * sampleRate)));
+    _releaseCoefficient = static_cast<float>(std::exp(-1.0 / (_releaseSeconds * sampleRate)));
+    reset();
+}
+
+void Limiter::reset()
+{
+    _delayLine.clear();
+    _writePosition = 0;
+    _framePosition = 0;
+    _framePeak = 0.0f;
+    _frameTargets.fill(1.0f);
+    _silentSamples = lookaheadSamples;
+    _gain = 1.0f;
+    _rampTarget = 1.0f;
+    _attackStep = 0.0f;
+}
+
+void Limiter::setLookahead(bool enabled)
+{
+    if (enabled == _lookahead)
+        return;
+    
+    _lookahead = enabled;
+    reset();
+}
+
+int Limiter::getLatencySamples(bool lookahead)
+{
+    return lookahead ? lookaheadSamples : 0;
+}
+
+void Limiter::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const auto numChannels = std::min(buffer.getNumChannels(), _numChannels);
+    
+    // Work through the block in pieces that end on frame boundaries
+    for (auto offset = 0; offset < numSamples;)
+    {
+        const auto chunkSize = std::min(numSamples - offset, frameSize - _framePosition);
+        if (_framePosition == 0 && _lookahead)
+        {
+            startOutputFrame();
+        }
+        
+        const auto chunkPeak = getInputPeak(buffer, offset, chunkSize);
+        _framePeak = std::max(_framePeak, chunkPeak);
+        _silentSamples = chunkPeak > 0.0f ? 0 : _silentSamples + chunkSize;
+        
+        if (_lookahead)
+        {
+            // Swap the chunk through the delay line, the gain ramp was set up for the frame coming out
+            auto writePosition = _writePosition;
+            for (auto i = 0; i < chunkSize; ++i)
+            {
+                const auto gain = getNextGain();
+                for (auto channel = 0; channel < numChannels; ++channel)
+                {
+                    auto* channelData = buffer.getWritePointer(channel, offset);
+                    auto* delayed = _delayLine.getWritePointer(channel) + writePosition;
+                    const auto input = channelData[i];
+                    channelData[i] = *delayed * gain;
+                    *delayed = input;
+                }
+                
+                writePosition = (writePosition + 1) % lookaheadSamples;
+            }
+            
+            _writePosition = writePosition;
+        }
+        else
+        {
+            // No frame to ramp across, the gain falls towards the chunk's target with the attack time constant
+            _rampTarget = chunkPeak > _ceiling ? _ceiling / chunkPeak : 1.0f;
+            _attackStep = 0.0f;
+            
+            for (auto i = 0; i < chunkSize; ++i)
+            {
+                const auto gain = getNextGain();
+                for (auto channel = 0; channel < numChannels; ++channel)
+                {
+                    buffer.getWritePointer(channel, offset)[i] *= gain;
+                }
+            }
+        }
+        
+        _framePosition += chunkSize;
+        if (_framePosition == frameSize)
+        {
+            std::rotate(_frameTargets.begin(), _frameTargets.begin() + 1, _frameTargets.end());
+            _frameTargets.back() = _framePeak > _ceiling ? _ceiling / _framePeak : 1.0f;
+            _framePeak = 0.0f;
+            _framePosition = 0;
+        }
+        
+        offset += chunkSize;
+    }
+}
+
+bool Limiter::isIdle() const
+{
+    return _gain >= 1.0f && _silentSamples >= lookaheadSamples;
+}
+
+// The frame leaving the delay line is the oldest complete one, the next is already known.
+// Ramping to the lower of their targets over the frame keeps every output sample under
+// the ceiling, since the ramp starts at or below this frame's target and ends at or below the next.
+void Limiter::startOutputFrame()
+{
+    const auto target = *std::min_element(_frameTargets.begin(), _frameTargets.end());
+    _rampTarget = target;
+    _attackStep = target < _gain ? (target - _gain) / static_cast<float>(frameSize) : 0.0f;
+}
+
+float Limiter::getInputPeak(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) const
+{
+    auto peak = 0.0f;
+    for (auto channel = 0; channel < std::min(buffer.getNumChannels(), _numChannels); ++channel)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(channel, startSample), numSamples);
+        peak = std::max({ peak, -range.getStart(), range.getEnd() });
+    }
+    
+    return peak;
+}
+
+float Limiter::getNextGain()
+{
+    if (_attackStep < 0.0f)
+    {
+        _gain = std::max(_rampTarget, _gain + _attackStep);
+    }
+    else if (_gain < _rampTarget)
+    {
+        // Release, snapping to the target once the remaining distance is inaudible
+        _gain = _rampTarget - (_rampTarget - _gain) * _releaseCoefficient;
+        if (_rampTarget - _gain < 1.0e-5f)
+        {
+            _gain = _rampTarget;
+        }
+    }
+    else if (_gain > _rampTarget)
+    {
+        // Only reached without lookahead, the lookahead ramps always come in through _attackStep
+        _gain = _rampTarget + (_gain - _rampTarget) * _attackCoefficient;
+    }
+    
+    return _gain;
+}
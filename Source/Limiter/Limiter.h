@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    Limiter.h
+    Created: 21 Oct 2026 1:18:36pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Master peak limiter. Peaks are found per 32-sample frame, and with lookahead the
+// audio is delayed by two frames, so the gain can ramp down across a whole frame
+// before a peak reaches the output. Without lookahead there is no latency, but the
+// gain can only react once a peak arrives: it falls with a 1ms attack rather than in a
+// step, so the first samples of a sudden peak can pass the ceiling. Release is exponential.
+class Limiter
+{
+public:
+    static constexpr int frameSize = 32;
+    static constexpr int lookaheadSamples = 2 * frameSize;
+    
+    Limiter() = default;
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+    
+    // Audio thread. Switching clears the delay line
+    void setLookahead(bool enabled);
+    static int getLatencySamples(bool lookahead);
+    
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+    bool isIdle() const; // No gain reduction and nothing left in the delay line
+    
+private:
+    static constexpr int _maxChannels = 2;
+    static constexpr float _ceiling = 0.891f; // -1dBFS
+    static constexpr double _attackSeconds = 0.001; // Without lookahead
+    static constexpr double _releaseSeconds = 0.15;
+    
+    juce::AudioBuffer<float> _delayLine; // Ring of lookaheadSamples per channel
+    int _writePosition = 0;
+    int _numChannels = 2;
+    bool _lookahead = true;
+    
+    // Frame targets are the gains that bring each complete input frame down to the ceiling
+    int _framePosition = 0;
+    float _framePeak = 0.0f;
+    std::array<float, lookaheadSamples / frameSize> _frameTargets; // Oldest first
+    int _silentSamples = lookaheadSamples;
+    
+    float _gain = 1.0f;
+    float _rampTarget = 1.0f;
+    float _attackStep = 0.0f;
+    float _attackCoefficient = 0.0f;
+    float _releaseCoefficient = 0.0f;
+    
+    // Helpers
+    void startOutputFrame();
+    float getInputPeak(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) const;
+    float getNextGain();
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Limiter)
+};
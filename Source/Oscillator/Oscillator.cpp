@@ -1,84 +1,243 @@
-/*
-  ==============================================================================
-
-    Oscillator.cpp
-    Created: 19 May 2025 3:38:17pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#include "Oscillator.h"
-#include "../Utils/OscillatorUtils.h"
-#include <JuceHeader.h>
-
-//==============================================================================
-// Public members
-//==============================================================================
-
-// constructor & destructor
-Oscillator::Oscillator() = default;
-Oscillator::~Oscillator() = default;
-
-// Get/Set the wave type (sine, square, triangle, saw)
-OscillatorUtils::WaveType Oscillator::getWaveType() const { return _waveType; }
-void Oscillator::setWaveType(OscillatorUtils::WaveType newType) { _waveType = newType; }
-
-// Reset the phase to a give starting phase
-void Oscillator::resetPhase(float startPhase) { _phase = startPhase; }
-
-// Set the oscillator frequency
-void Oscillator::setFrequency(float freqHz, float sampleRateHz)
-{
-    _frequency = freqHz;
-    _sampleRate = sampleRateHz;
-    updatePhaseIncrement();
-}
-
-// Set the pulse width and bound it in between 0.01 & 0.99
-void Oscillator::setPulseWidth(float pw)
-{
-    _pulseWidth = std::clamp(pw, 0.01f, 0.99f);
-}
-
-float Oscillator::processSample()
-{
-    const float sample = generateSample();
-    advancePhase();
-    return sample;
-}
-
-//==============================================================================
-// Private members
-//==============================================================================
-void Oscillator::updatePhaseIncrement()
-{
-    _phaseIncrement = _frequency / _sampleRate;
-}
-
-void Oscillator::advancePhase()
-{
-    _phase += _phaseIncrement;
-    while (_phase >= 1.0f)
-    {
-        _phase -= 1.0f;
-    }
-}
-
-float Oscillator::generateSample()
-{
-    const float twoPi = juce::MathConstants<float>::twoPi;
-    switch (_waveType)
-    {
-        case OscillatorUtils::WaveType::Sine:
-            return std::sin(_phase * twoPi);
-        case OscillatorUtils::WaveType::Square:
-            return (_phase < _pulseWidth) ? 1.0f : -1.0f;
-        case OscillatorUtils::WaveType::Saw:
-            return 2.0f * _phase -1.0f;
-        case OscillatorUtils::WaveType::Triangle:
-            return 1.0f - 4.0f * std::abs(_phase - 0.5f);
-        default:
-            return 0.0f;
-    }
-}
+/*
+  ==============================================================================
+
+    Oscillator.cpp
+    Created: 19 May 2025 3:38:17pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "Oscillator.h"
+#include "../Utils/OscillatorUtils.h"
+#include <JuceHeader.h>
+
+namespace
+{
+    constexpr double phaseRange = 4294967296.0; // 2^32
+    constexpr float phaseToFloat = 1.0f / 4294967296.0f;
+    
+    // Sine wavetable indexed by the top bits of the phase, the remaining bits interpolate.
+    // 2048 points with linear interpolation stay within ~1.2e-6 of std::sin.
+    constexpr int sineTableBits = 11;
+    constexpr int sineTableSize = 1 << sineTableBits;
+    constexpr int sineFractionBits = 32 - sineTableBits;
+    constexpr uint32_t sineFractionMask = (1u << sineFractionBits) - 1;
+    constexpr float sineFractionScale = 1.0f / static_cast<float>(1u << sineFractionBits);
+    
+    std::array<float, sineTableSize + 1> createSineTable()
+    {
+        std::array<float, sineTableSize + 1> table {};
+        for (auto i = 0; i <= sineTableSize; ++i)
+        {
+            table[static_cast<size_t>(i)] = static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * i / sineTableSize));
+        }
+        
+        return table;
+    }
+    
+    // Built once at load time and shared read-only by every oscillator
+    const auto sineTable = createSineTable();
+    
+    uint32_t toPhase(double normalisedPhase)
+    {
+        normalisedPhase -= std::floor(normalisedPhase);
+        return static_cast<uint32_t>(static_cast<uint64_t>(normalisedPhase * phaseRange) & 0xffffffffu);
+    }
+}
+
+//==============================================================================
+// Public members
+//==============================================================================
+
+// constructor & destructor
+Oscillator::Oscillator() = default;
+Oscillator::~Oscillator() = default;
+
+// Get/Set the wave type (sine, square, triangle, saw)
+OscillatorUtils::WaveType Oscillator::getWaveType() const { return _requestedWaveType.load(std::memory_order_relaxed); }
+void Oscillator::setWaveType(OscillatorUtils::WaveType newType)
+{
+    _requestedWaveType.store(newType, std::memory_order_relaxed);
+}
+
+// Reset the phase to a give starting phase
+void Oscillator::resetPhase(float startPhase) { _phase = toPhase(startPhase); }
+
+// Set the oscillator frequency
+void Oscillator::setFrequency(float freqHz, float sampleRateHz)
+{
+    _frequency = freqHz;
+    _sampleRate = sampleRateHz;
+    updatePhaseIncrement();
+    _samplePlayer.setFrequency(freqHz, sampleRateHz);
+}
+
+// Set the pulse width and bound it in between 0.01 & 0.99
+void Oscillator::setPulseWidth(float pw)
+{
+    _pulseWidth = std::clamp(pw, 0.01f, 0.99f);
+    _pulseWidthPhase = toPhase(_pulseWidth);
+}
+
+float Oscillator::processSample()
+{
+    applyWaveType();
+    if (_waveType == OscillatorUtils::WaveType::Sample)
+    {
+        float sample;
+        _samplePlayer.processBlock(&sample, 1);
+        return sample;
+    }
+    
+    const float sample = generateSample();
+    advancePhase();
+    return sample;
+}
+
+// Fill the output with the next numSamples of the wave
+void Oscillator::processBlock(float* output, int numSamples)
+{
+    applyWaveType();
+    (this->*_blockRenderer)(output, numSamples);
+}
+
+// Move the phase on as if numSamples had been rendered, without rendering them
+void Oscillator::advance(int numSamples)
+{
+    applyWaveType();
+    if (_waveType == OscillatorUtils::WaveType::Sample)
+    {
+        _samplePlayer.advance(numSamples);
+        return;
+    }
+    
+    _phase += static_cast<uint32_t>(numSamples) * _phaseIncrement; // Exact, wraps modulo 2^32
+}
+
+void Oscillator::setSampleStreamer(SampleStreamer* streamer)
+{
+    _samplePlayer.setStreamer(streamer);
+}
+
+// Picks the zone for the note, the frequency has to be set first
+void Oscillator::startNote(int midiNote)
+{
+    applyWaveType();
+    if (_waveType == OscillatorUtils::WaveType::Sample)
+    {
+        _samplePlayer.startNote(midiNote);
+    }
+}
+
+void Oscillator::stopNote()
+{
+    _samplePlayer.stopNote();
+}
+
+//==============================================================================
+// Private members
+//==============================================================================
+// Runs on the audio thread at the start of each block, so only the audio thread ever
+// touches the sample player and the stream it holds
+void Oscillator::applyWaveType()
+{
+    const auto newType = _requestedWaveType.load(std::memory_order_relaxed);
+    if (newType == _waveType)
+        return;
+    
+    if (newType != OscillatorUtils::WaveType::Sample)
+    {
+        _samplePlayer.stopNote();
+    }
+    
+    _waveType = newType;
+    _blockRenderer = getBlockRenderer(newType);
+}
+
+void Oscillator::updatePhaseIncrement()
+{
+    _phaseIncrement = (_sampleRate > 0.0f) ? toPhase(static_cast<double>(_frequency) / _sampleRate) : 0;
+}
+
+void Oscillator::advancePhase()
+{
+    _phase += _phaseIncrement;
+}
+
+float Oscillator::generateSample()
+{
+    switch (_waveType)
+    {
+        case OscillatorUtils::WaveType::Sine:
+            return generateSample<OscillatorUtils::WaveType::Sine>(_phase, _pulseWidthPhase);
+        case OscillatorUtils::WaveType::Square:
+            return generateSample<OscillatorUtils::WaveType::Square>(_phase, _pulseWidthPhase);
+        case OscillatorUtils::WaveType::Saw:
+            return generateSample<OscillatorUtils::WaveType::Saw>(_phase, _pulseWidthPhase);
+        case OscillatorUtils::WaveType::Triangle:
+            return generateSample<OscillatorUtils::WaveType::Triangle>(_phase, _pulseWidthPhase);
+        default:
+            return 0.0f;
+    }
+}
+
+template <OscillatorUtils::WaveType Type>
+float Oscillator::generateSample(uint32_t phase, uint32_t pulseWidthPhase)
+{
+    if constexpr (Type == OscillatorUtils::WaveType::Sine)
+    {
+        const auto index = phase >> sineFractionBits;
+        const auto fraction = static_cast<float>(phase & sineFractionMask) * sineFractionScale;
+        const auto a = sineTable[index];
+        return a + fraction * (sineTable[index + 1] - a);
+    }
+    else if constexpr (Type == OscillatorUtils::WaveType::Square)
+        return (phase < pulseWidthPhase) ? 1.0f : -1.0f;
+    else if constexpr (Type == OscillatorUtils::WaveType::Saw)
+        return 2.0f * (static_cast<float>(phase) * phaseToFloat) - 1.0f;
+    else if constexpr (Type == OscillatorUtils::WaveType::Triangle)
+        return 1.0f - 4.0f * std::abs(static_cast<float>(phase) * phaseToFloat - 0.5f);
+    else
+        return 0.0f;
+}
+
+template <OscillatorUtils::WaveType Type>
+void Oscillator::renderBlock(float* output, int numSamples)
+{
+    // Work on locals so the compiler can keep everything in registers
+    auto phase = _phase;
+    const auto phaseIncrement = _phaseIncrement;
+    const auto pulseWidthPhase = _pulseWidthPhase;
+    
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        output[i] = generateSample<Type>(phase, pulseWidthPhase);
+        phase += phaseIncrement; // Wraps modulo 2^32, no branch needed
+    }
+    
+    _phase = phase;
+}
+
+void Oscillator::renderSampleBlock(float* output, int numSamples)
+{
+    _samplePlayer.processBlock(output, numSamples);
+}
+
+Oscillator::BlockRenderer Oscillator::getBlockRenderer(OscillatorUtils::WaveType type)
+{
+    switch (type)
+    {
+        case OscillatorUtils::WaveType::Square:
+            return &Oscillator::renderBlock<OscillatorUtils::WaveType::Square>;
+        case OscillatorUtils::WaveType::Saw:
+            return &Oscillator::renderBlock<OscillatorUtils::WaveType::Saw>;
+        case OscillatorUtils::WaveType::Triangle:
+            return &Oscillator::renderBlock<OscillatorUtils::WaveType::Triangle>;
+        case OscillatorUtils::WaveType::Sample:
+            return &Oscillator::renderSampleBlock;
+        case OscillatorUtils::WaveType::Sine:
+        default:
+            return &Oscillator::renderBlock<OscillatorUtils::WaveType::Sine>;
+    }
+}
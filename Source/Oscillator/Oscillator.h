@@ -1,41 +1,68 @@
-/*
-  ==============================================================================
-
- Oscillator.h
-    Created: 19 May 2025 3:38:17pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <JuceHeader.h>
-#include "../Utils/OscillatorUtils.h"
-
-class Oscillator {
-public:
-    // Constructor & destructor
-    Oscillator();
-    ~Oscillator();
-    
-    // enum for supported wave types
-    OscillatorUtils::WaveType getWaveType() const;
-    void setWaveType(OscillatorUtils::WaveType type);
-    void setFrequency(float freqHz, float sampleRateHz);
-    void setPulseWidth(float pw);
-    void resetPhase(float startPhase = 0.0f);
-    float processSample();
-private:
-    float _frequency = 440.0f;
-    float _sampleRate = 44100.0f;
-    float _phase = 0.0f;
-    float _phaseIncrement = 0.0f;
-    float _pulseWidth = 0.5f; // For square wave pwm
-    OscillatorUtils::WaveType _waveType = OscillatorUtils::WaveType::Sine; // Initial wave type
-    
-    void updatePhaseIncrement();
-    void advancePhase();
-    float generateSample();
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oscillator)
-};
+/*
+  ==============================================================================
+
+ Oscillator.h
+    Created: 19 May 2025 3:38:17pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utils/OscillatorUtils.h"
+#include "../Sampler/SamplePlayer.h"
+
+class Oscillator {
+public:
+    // Constructor & destructor
+    Oscillator();
+    ~Oscillator();
+    
+    // enum for supported wave types
+    OscillatorUtils::WaveType getWaveType() const;
+    void setWaveType(OscillatorUtils::WaveType type);
+    void setFrequency(float freqHz, float sampleRateHz);
+    void setPulseWidth(float pw);
+    void resetPhase(float startPhase = 0.0f);
+    float processSample();
+    void processBlock(float* output, int numSamples);
+    void advance(int numSamples);
+    
+    // Sample playback, the other wave types ignore these
+    void setSampleStreamer(SampleStreamer* streamer);
+    void startNote(int midiNote);
+    void stopNote();
+private:
+    using BlockRenderer = void (Oscillator::*)(float*, int);
+    
+    float _frequency = 440.0f;
+    float _sampleRate = 44100.0f;
+    
+    // 32-bit fixed-point phase: one cycle is 2^32, so it wraps on its own and never drifts
+    uint32_t _phase = 0;
+    uint32_t _phaseIncrement = 0;
+    uint32_t _pulseWidthPhase = 0x80000000u;
+    float _pulseWidth = 0.5f; // For square wave pwm
+    OscillatorUtils::WaveType _waveType = OscillatorUtils::WaveType::Sine; // Initial wave type
+    std::atomic<OscillatorUtils::WaveType> _requestedWaveType = OscillatorUtils::WaveType::Sine; // Set from the message thread, applied by applyWaveType
+    BlockRenderer _blockRenderer = &Oscillator::renderBlock<OscillatorUtils::WaveType::Sine>;
+    SamplePlayer _samplePlayer;
+    
+    void applyWaveType();
+    void updatePhaseIncrement();
+    void advancePhase();
+    float generateSample();
+    
+    // One branch-free kernel per wave type, picked when the wave type changes
+    template <OscillatorUtils::WaveType Type>
+    static float generateSample(uint32_t phase, uint32_t pulseWidthPhase);
+    
+    template <OscillatorUtils::WaveType Type>
+    void renderBlock(float* output, int numSamples);
+    void renderSampleBlock(float* output, int numSamples);
+    
+    static BlockRenderer getBlockRenderer(OscillatorUtils::WaveType type);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oscillator)
+};
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    Oversampler.cpp
+    Created: 20 Oct 2026 2:31:08pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "Oversampler.h"
+
+void Oversampler::prepare(int samplesPerBlock, int numChannels)
+{
+    for (auto filter = 0; filter < _numFilters; ++filter)
+    {
+        const auto filterType = static_cast<Filter>(filter) == Filter::PolyphaseIir
+                                    ? juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR
+                                    : juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple;
+        
+        for (auto stages = 1; stages <= _numFactors; ++stages)
+        {
+            auto& oversampler = _oversamplers[static_cast<size_t>(filter * _numFactors + stages - 1)];
+            oversampler = std::make_unique<juce::dsp::Oversampling<float>>(static_cast<size_t>(numChannels),
+                                                                           static_cast<size_t>(stages),
+                                                                           filterType,
+                                                                           true,  // Steepest filters
+                                                                           true); // Whole-sample latency the host can compensate
+            oversampler->initProcessing(static_cast<size_t>(samplesPerBlock));
+        }
+    }
+    
+    _active = getOversampler(_factor, _filter);
+}
+
+void Oversampler::reset()
+{
+    if (_active != nullptr)
+    {
+        _active->reset();
+    }
+}
+
+void Oversampler::setFactor(EngineUtils::OversamplingFactor factor, Filter filter)
+{
+    if (factor == _factor && filter == _filter)
+        return;
+    
+    _factor = factor;
+    _filter = filter;
+    _active = getOversampler(factor, filter);
+    reset();
+}
+
+int Oversampler::getFactor() const
+{
+    return 1 << static_cast<int>(_factor);
+}
+
+bool Oversampler::isEnabled() const
+{
+    return _active != nullptr;
+}
+
+int Oversampler::getLatencySamples(EngineUtils::OversamplingFactor factor, Filter filter) const
+{
+    const auto* oversampler = getOversampler(factor, filter);
+    return oversampler != nullptr ? juce::roundToInt(oversampler->getLatencyInSamples()) : 0;
+}
+
+juce::dsp::AudioBlock<float> Oversampler::beginRender(juce::AudioBuffer<float>& output, int startSample, int numSamples)
+{
+    // JUCE only hands out its oversampled buffer from the up stage, so the silent output is pushed through it first
+    juce::dsp::AudioBlock<float> outputBlock(output);
+    auto oversampledBlock = _active->processSamplesUp(outputBlock.getSubBlock(static_cast<size_t>(startSample), static_cast<size_t>(numSamples)));
+    oversampledBlock.clear();
+    return oversampledBlock;
+}
+
+void Oversampler::endRender(juce::AudioBuffer<float>& output, int startSample, int numSamples)
+{
+    juce::dsp::AudioBlock<float> outputBlock(output);
+    auto block = outputBlock.getSubBlock(static_cast<size_t>(startSample), static_cast<size_t>(numSamples));
+    _active->processSamplesDown(block);
+}
+
+juce::dsp::Oversampling<float>* Oversampler::getOversampler(EngineUtils::OversamplingFactor factor, Filter filter) const
+{
+    if (factor == EngineUtils::OversamplingFactor::Off)
+        return nullptr;
+    
+    const auto index = static_cast<int>(filter) * _numFactors + static_cast<int>(factor) - 1;
+    return _oversamplers[static_cast<size_t>(index)].get();
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    Oversampler.h
+    Created: 20 Oct 2026 2:31:08pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utils/EngineUtils.h"
+
+// Renders at 2x, 4x or 8x the host rate and decimates back through JUCE's cascaded
+// half-band filters. Every factor is built for both filter designs in prepare(), so
+// switching on the audio thread never allocates. The polyphase IIR filters add almost
+// no latency and suit live playback; the linear-phase FIR filters cost more and suit
+// offline rendering.
+class Oversampler
+{
+public:
+    enum class Filter : uint8_t
+    {
+        PolyphaseIir,
+        LinearPhaseFir
+    };
+    
+    Oversampler() = default;
+    ~Oversampler() = default;
+    
+    void prepare(int samplesPerBlock, int numChannels);
+    void reset();
+    
+    // Audio thread. The newly selected filters start from silence
+    void setFactor(EngineUtils::OversamplingFactor factor, Filter filter);
+    int getFactor() const;
+    bool isEnabled() const;
+    int getLatencySamples(EngineUtils::OversamplingFactor factor, Filter filter) const;
+    
+    // Fill the returned block at the oversampled rate, then endRender decimates it into output
+    juce::dsp::AudioBlock<float> beginRender(juce::AudioBuffer<float>& output, int startSample, int numSamples);
+    void endRender(juce::AudioBuffer<float>& output, int startSample, int numSamples);
+    
+private:
+    static constexpr int _numFactors = 3; // 2x, 4x and 8x
+    static constexpr int _numFilters = 2;
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, _numFactors * _numFilters> _oversamplers;
+    juce::dsp::Oversampling<float>* _active = nullptr;
+    EngineUtils::OversamplingFactor _factor = EngineUtils::OversamplingFactor::Off;
+    Filter _filter = Filter::PolyphaseIir;
+    
+    // Helpers
+    juce::dsp::Oversampling<float>* getOversampler(EngineUtils::OversamplingFactor factor, Filter filter) const;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampler)
+};
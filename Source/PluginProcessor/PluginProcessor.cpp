@@ -1,338 +1,889 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "../GUI/PluginEditor/PluginEditor.h"
-#include "../Constants/ParameterIds.h"
-
-//==============================================================================
-PluginProcessor::PluginProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor(BusesProperties()
-         #if ! JucePlugin_IsMidiEffect
-          #if ! JucePlugin_IsSynth
-           .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-          #endif
-           .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-         #endif
-        ),
-_audioProcessorValueTreeState(*this, nullptr, "Parameters", createParameterLayout())
-#endif
-{
-    initializeParameterListeners();
-}
-
-PluginProcessor::~PluginProcessor()
-{
-    for (auto* param : ParameterIds::parameterIds)
-    {
-        _audioProcessorValueTreeState.removeParameterListener(param, this);
-    }
-
-}
-
-
-//==============================================================================
-juce::AudioProcessorValueTreeState::ParameterLayout PluginProcessor::createParameterLayout()
-{
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    // Oscillators
-    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OscillatorATypeId,
-                                                                  "Oscillator A",
-                                                                  juce::StringArray { "Sine", "Square", "Saw", "Triangle" },
-                                                                  0));
-    
-    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OscillatorBTypeId,
-                                                                  "Oscillator B",
-                                                                  juce::StringArray { "Sine", "Square", "Saw", "Triangle" },
-                                                                  0));
-    
-    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OscillatorSubTypeId,
-                                                                  "Sub Oscillator",
-                                                                  juce::StringArray { "Sine", "Square" },
-                                                                  0));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::OscillatorAGainId,  "Osc A Gain",  juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::OscillatorBGainId,   "Osc B Gain",   juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::OscillatorSubGainId, "Sub Gain", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
-    
-    // Envelopes
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeAttackId,  "Amp Attack",  0.0f, 5.0f, 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeDecayId,   "Amp Decay",   0.01f, 5.0f, 0.1f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeSustainId, "Amp Sustain", 0.0f,  1.0f, 1.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeReleaseId, "Amp Release", 0.01f, 5.0f, 0.1f));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeAttackId,  "Mod Attack",  0.00f, 5.0f, 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeDecayId,   "Mod Decay",   0.01f, 5.0f, 0.1f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeSustainId, "Mod Sustain", 0.0f,  1.0f, 1.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeReleaseId, "Mod Release", 0.01f, 5.0f, 0.1f));
-    
-    // Master Gain
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::MasterGainId, "Master Gain", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.8f));
-
-    return { params.begin(), params.end() };
-}
-
-void PluginProcessor::addParameterListener(const juce::String& paramId)
-{
-    _audioProcessorValueTreeState.addParameterListener(paramId, this);
-}
-
-void PluginProcessor::initializeParameterListeners()
-{
-    // Oscillators
-    addParameterListener(ParameterIds::OscillatorATypeId);
-    addParameterListener(ParameterIds::OscillatorBTypeId);
-    addParameterListener(ParameterIds::OscillatorSubTypeId);
-    
-    addParameterListener(ParameterIds::OscillatorAGainId);
-    addParameterListener(ParameterIds::OscillatorBGainId);
-    addParameterListener(ParameterIds::OscillatorSubGainId);
-
-    // Envelopes
-    addParameterListener(ParameterIds::AmplitudeEnvelopeAttackId);
-    addParameterListener(ParameterIds::AmplitudeEnvelopeDecayId);
-    addParameterListener(ParameterIds::AmplitudeEnvelopeSustainId);
-    addParameterListener(ParameterIds::AmplitudeEnvelopeReleaseId);
-
-    addParameterListener(ParameterIds::ModulationEnvelopeAttackId);
-    addParameterListener(ParameterIds::ModulationEnvelopeDecayId);
-    addParameterListener(ParameterIds::ModulationEnvelopeSustainId);
-    addParameterListener(ParameterIds::ModulationEnvelopeReleaseId);
-    
-    // Master Gain
-    addParameterListener(ParameterIds::MasterGainId);
-}
-
-void PluginProcessor::parameterChanged(const juce::String& parameterID, float newValue)
-{
-    using WaveType = OscillatorUtils::WaveType;
-    
-    if (parameterID == ParameterIds::OscillatorATypeId)
-    {
-        _synthEngine.setOscillatorAType(static_cast<WaveType>(static_cast<int>(newValue)));
-    }
-    else if (parameterID == ParameterIds::OscillatorBTypeId)
-    {
-        _synthEngine.setOscillatorBType(static_cast<WaveType>(static_cast<int>(newValue)));
-    }
-    else if (parameterID == ParameterIds::OscillatorSubTypeId)
-    {
-        _synthEngine.setOscillatorSubType(static_cast<WaveType>(static_cast<int>(newValue)));
-    }
-    else if (parameterID == ParameterIds::OscillatorAGainId)
-    {
-        _synthEngine.setOscillatorAGain(newValue);
-    }
-    else if (parameterID == ParameterIds::OscillatorBGainId)
-    {
-        _synthEngine.setOscillatorBGain(newValue);
-    }
-    else if (parameterID == ParameterIds::OscillatorSubGainId)
-    {
-        _synthEngine.setOscillatorSubGain(newValue);
-    }
-    else if (parameterID == ParameterIds::AmplitudeEnvelopeAttackId ||
-             parameterID == ParameterIds::AmplitudeEnvelopeDecayId ||
-             parameterID == ParameterIds::AmplitudeEnvelopeSustainId ||
-             parameterID == ParameterIds::AmplitudeEnvelopeReleaseId)
-    {
-        auto p = juce::ADSR::Parameters{
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::AmplitudeEnvelopeAttackId)->load(),
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::AmplitudeEnvelopeDecayId)->load(),
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::AmplitudeEnvelopeSustainId)->load(),
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::AmplitudeEnvelopeReleaseId)->load()
-        };
-        
-        _synthEngine.setAmplitudeEnvelopeParams(p);
-    }
-    else if (parameterID == ParameterIds::ModulationEnvelopeAttackId ||
-             parameterID == ParameterIds::ModulationEnvelopeDecayId ||
-             parameterID == ParameterIds::ModulationEnvelopeSustainId ||
-             parameterID == ParameterIds::ModulationEnvelopeReleaseId)
-    {
-        auto p = juce::ADSR::Parameters{
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::ModulationEnvelopeAttackId)->load(),
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::ModulationEnvelopeDecayId)->load(),
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::ModulationEnvelopeSustainId)->load(),
-            _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::ModulationEnvelopeReleaseId)->load()
-        };
-        
-        _synthEngine.setModulationEnvelopeParams(p);
-    }
-    else if (parameterID == ParameterIds::MasterGainId)
-    {
-        _synthEngine.setMasterGain(newValue);
-    }
-}
-
-
-const juce::String PluginProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool PluginProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool PluginProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool PluginProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double PluginProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int PluginProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int PluginProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void PluginProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String PluginProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void PluginProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void PluginProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    _synthEngine.prepareToPlay(sampleRate, samplesPerBlock);
-    
-    // Master gain
-    if (auto * masterGainParam = _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::MasterGainId))
-    {
-        _synthEngine.setMasterGain(std::clamp(masterGainParam->load(), 0.0f, 1.0f));
-    }
-    
-    // Oscillator Gains
-    if (auto* oscAGain = _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::OscillatorAGainId))
-    {
-        _synthEngine.setOscillatorAGain(std::clamp(oscAGain->load(), 0.0f, 1.0f));
-    }
-
-    if (auto* oscBGain = _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::OscillatorBGainId))
-    {
-        _synthEngine.setOscillatorBGain(std::clamp(oscBGain->load(), 0.0f, 1.0f));
-    }
-
-    if (auto* subGain = _audioProcessorValueTreeState.getRawParameterValue(ParameterIds::OscillatorSubGainId))
-    {
-        _synthEngine.setOscillatorSubGain(std::clamp(subGain->load(), 0.0f, 1.0f));
-    }
-}
-
-void PluginProcessor::releaseResources()
-{
-    _synthEngine.reset();
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool PluginProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-void PluginProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    buffer.clear();
-    _synthEngine.processBlock(buffer, midiMessages);
-}
-
-//==============================================================================
-bool PluginProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* PluginProcessor::createEditor()
-{
-    return new PluginEditor (*this);
-}
-
-//==============================================================================
-void PluginProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // Serialize tree to memory
-    juce::MemoryOutputStream stream(destData, true);
-    _audioProcessorValueTreeState.state.writeToStream(stream);
-}
-
-void PluginProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    auto stateTree = juce::ValueTree::readFromData(data, static_cast<size_t>(sizeInBytes));
-    if (stateTree.isValid() && stateTree.getType() == juce::Identifier("SynthState"))
-    {
-        _audioProcessorValueTreeState.state = stateTree;
-    }
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new PluginProcessor();
-}
-
-SynthEngine& PluginProcessor::getSynthEngine() { return _synthEngine; }
-juce::AudioProcessorValueTreeState& PluginProcessor::getAudioProcessorValueTreeState() {return _audioProcessorValueTreeState; }
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "../GUI/PluginEditor/PluginEditor.h"
+#include "../Constants/ParameterIds.h"
+
+//==============================================================================
+PluginProcessor::PluginProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor(BusesProperties()
+         #if ! JucePlugin_IsMidiEffect
+          #if ! JucePlugin_IsSynth
+           .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+          #endif
+           .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+         #endif
+        ),
+_audioProcessorValueTreeState(*this, nullptr, "Parameters", createParameterLayout())
+#endif
+{
+    // Every part starts from the default patch
+    for (auto& patch : _partPatches)
+    {
+        for (auto i = 0; i < SessionLog::numParameters; ++i)
+        {
+            patch[static_cast<size_t>(i)].store(_audioProcessorValueTreeState.getRawParameterValue(ParameterIds::parameterIds[i])->load());
+        }
+    }
+    
+    initializeParameterListeners();
+    
+    // Nothing is shown or reported to the host before prepareToPlay anyway
+    applyParameters();
+    _patchPartChanged.store(false);
+    _latencyChanged.store(false);
+    startTimer(_messageThreadUpdateMs);
+    
+    // Lets a problem session be captured from the host without a UI for it
+    auto captureFile = juce::SystemStats::getEnvironmentVariable(_sessionCaptureEnvironmentVariable, {});
+    if (captureFile.isNotEmpty())
+    {
+        startSessionCapture(juce::File(captureFile));
+    }
+}
+
+PluginProcessor::~PluginProcessor()
+{
+    stopTimer();
+    stopSessionCapture();
+    
+    for (auto* param : ParameterIds::parameterIds)
+    {
+        _audioProcessorValueTreeState.removeParameterListener(param, this);
+    }
+
+}
+
+
+//==============================================================================
+juce::AudioProcessorValueTreeState::ParameterLayout PluginProcessor::createParameterLayout()
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+
+    // Oscillators
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OscillatorATypeId,
+                                                                  "Oscillator A",
+                                                                  juce::StringArray { "Sine", "Square", "Saw", "Triangle", "Sample" },
+                                                                  0));
+    
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OscillatorBTypeId,
+                                                                  "Oscillator B",
+                                                                  juce::StringArray { "Sine", "Square", "Saw", "Triangle", "Sample" },
+                                                                  0));
+    
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OscillatorSubTypeId,
+                                                                  "Sub Oscillator",
+                                                                  juce::StringArray { "Sine", "Square" },
+                                                                  0));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::OscillatorAGainId,  "Osc A Gain",  juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::OscillatorBGainId,   "Osc B Gain",   juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::OscillatorSubGainId, "Sub Gain", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
+    
+    // Envelopes
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeAttackId,  "Amp Attack",  0.0f, 5.0f, 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeDecayId,   "Amp Decay",   0.01f, 5.0f, 0.1f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeSustainId, "Amp Sustain", 0.0f,  1.0f, 1.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::AmplitudeEnvelopeReleaseId, "Amp Release", 0.01f, 5.0f, 0.1f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeAttackId,  "Mod Attack",  0.00f, 5.0f, 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeDecayId,   "Mod Decay",   0.01f, 5.0f, 0.1f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeSustainId, "Mod Sustain", 0.0f,  1.0f, 1.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ModulationEnvelopeReleaseId, "Mod Release", 0.01f, 5.0f, 0.1f));
+    
+    // Master Gain
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::MasterGainId, "Master Gain", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.8f));
+    
+    // Play mode and glide
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::PlayModeId,
+                                                                  "Play Mode",
+                                                                  juce::StringArray { "Mono", "Duo", "Poly" },
+                                                                  2));
+    
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::NotePriorityId,
+                                                                  "Note Priority",
+                                                                  juce::StringArray { "Last", "Low", "High" },
+                                                                  0));
+    
+    params.push_back(std::make_unique<juce::AudioParameterBool>(ParameterIds::LegatoId, "Legato", true));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::GlideTimeId, "Glide Time", juce::NormalisableRange<float>(0.0f, 2.0f, 0.001f, 0.4f), 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::GlideModeId,
+                                                                  "Glide Mode",
+                                                                  juce::StringArray { "Constant Time", "Constant Rate" },
+                                                                  0));
+    
+    // MPE
+    params.push_back(std::make_unique<juce::AudioParameterBool>(ParameterIds::MpeEnabledId, "MPE", false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::MpePitchBendRangeId, "MPE Bend Range", juce::NormalisableRange<float>(0.0f, 96.0f, 1.0f), 48.0f));
+    
+    // Multi-timbral
+    params.push_back(std::make_unique<juce::AudioParameterBool>(ParameterIds::MultiTimbralId, "Multi-timbral", false));
+    params.push_back(std::make_unique<juce::AudioParameterInt>(ParameterIds::EditPartId, "Edit Part", 1, MultiTimbralEngine::numParts, 1));
+    params.push_back(std::make_unique<juce::AudioParameterInt>(ParameterIds::PartPolyphonyId, "Part Polyphony", 1, 8, 8));
+    params.push_back(std::make_unique<juce::AudioParameterInt>(ParameterIds::VoiceBudgetId, "Voice Budget", 1, 128, 32));
+    
+    // Oversampling
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OversamplingId,
+                                                                  "Oversampling",
+                                                                  juce::StringArray { "Off", "2x", "4x", "8x" },
+                                                                  0));
+    
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::OfflineOversamplingId,
+                                                                  "Offline Oversampling",
+                                                                  juce::StringArray { "Off", "2x", "4x", "8x" },
+                                                                  2));
+    
+    // Master limiter
+    params.push_back(std::make_unique<juce::AudioParameterBool>(ParameterIds::LimiterLookaheadId, "Limiter Lookahead", true));
+    
+    // Reverb
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ReverbMixId, "Reverb Mix", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ReverbDecayId, "Reverb Decay", juce::NormalisableRange<float>(0.2f, 10.0f, 0.01f, 0.4f), 2.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ReverbDampingId, "Reverb Damping", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+    
+    // Delay, divisions in the order of StereoDelay::divisionBeats
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::DelayMixId, "Delay Mix", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterBool>(ParameterIds::DelaySyncId, "Delay Sync", true));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::DelayDivisionId,
+                                                                  "Delay Division",
+                                                                  juce::StringArray { "1/32", "1/16T", "1/16", "1/16D", "1/8T", "1/8", "1/8D", "1/4T", "1/4", "1/4D", "1/2", "1/1" },
+                                                                  5));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::DelayTimeId, "Delay Time", juce::NormalisableRange<float>(1.0f, 4000.0f, 0.1f, 0.4f), 375.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::DelayFeedbackId, "Delay Feedback", juce::NormalisableRange<float>(0.0f, 0.95f, 0.01f), 0.4f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::DelayToneId, "Delay Tone", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.6f));
+    params.push_back(std::make_unique<juce::AudioParameterBool>(ParameterIds::DelayPingPongId, "Delay Ping-Pong", false));
+    
+    // Chorus
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ChorusMixId, "Chorus Mix", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ChorusRateId, "Chorus Rate", juce::NormalisableRange<float>(0.05f, 5.0f, 0.01f, 0.5f), 0.6f));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ChorusDepthId, "Chorus Depth", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+    params.push_back(std::make_unique<juce::AudioParameterInt>(ParameterIds::ChorusTapsId, "Chorus Taps", 1, EnsembleChorus::maxTaps, EnsembleChorus::maxTaps));
+    
+    // Saturation, per voice in each part's patch and once more on the bus
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::VoiceDriveId, "Voice Drive", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::VoiceDriveShapeId,
+                                                                  "Voice Drive Shape",
+                                                                  juce::StringArray { "Tanh", "Hard Clip", "Foldback" },
+                                                                  0));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::BusDriveId, "Bus Drive", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(ParameterIds::BusDriveShapeId,
+                                                                  "Bus Drive Shape",
+                                                                  juce::StringArray { "Tanh", "Hard Clip", "Foldback" },
+                                                                  0));
+    
+    // Convolution, the response itself is loaded from a file
+    params.push_back(std::make_unique<juce::AudioParameterBool>(ParameterIds::ConvolutionEnabledId, "Convolution", false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(ParameterIds::ConvolutionMixId, "Convolution Mix", juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 1.0f));
+
+    return { params.begin(), params.end() };
+}
+
+void PluginProcessor::addParameterListener(const juce::String& paramId)
+{
+    _audioProcessorValueTreeState.addParameterListener(paramId, this);
+}
+
+void PluginProcessor::initializeParameterListeners()
+{
+    // Oscillators
+    addParameterListener(ParameterIds::OscillatorATypeId);
+    addParameterListener(ParameterIds::OscillatorBTypeId);
+    addParameterListener(ParameterIds::OscillatorSubTypeId);
+    
+    addParameterListener(ParameterIds::OscillatorAGainId);
+    addParameterListener(ParameterIds::OscillatorBGainId);
+    addParameterListener(ParameterIds::OscillatorSubGainId);
+
+    // Envelopes
+    addParameterListener(ParameterIds::AmplitudeEnvelopeAttackId);
+    addParameterListener(ParameterIds::AmplitudeEnvelopeDecayId);
+    addParameterListener(ParameterIds::AmplitudeEnvelopeSustainId);
+    addParameterListener(ParameterIds::AmplitudeEnvelopeReleaseId);
+
+    addParameterListener(ParameterIds::ModulationEnvelopeAttackId);
+    addParameterListener(ParameterIds::ModulationEnvelopeDecayId);
+    addParameterListener(ParameterIds::ModulationEnvelopeSustainId);
+    addParameterListener(ParameterIds::ModulationEnvelopeReleaseId);
+    
+    // Master Gain
+    addParameterListener(ParameterIds::MasterGainId);
+    
+    // Play mode and glide
+    addParameterListener(ParameterIds::PlayModeId);
+    addParameterListener(ParameterIds::NotePriorityId);
+    addParameterListener(ParameterIds::LegatoId);
+    addParameterListener(ParameterIds::GlideTimeId);
+    addParameterListener(ParameterIds::GlideModeId);
+    
+    // MPE
+    addParameterListener(ParameterIds::MpeEnabledId);
+    addParameterListener(ParameterIds::MpePitchBendRangeId);
+    
+    // Multi-timbral
+    addParameterListener(ParameterIds::MultiTimbralId);
+    addParameterListener(ParameterIds::EditPartId);
+    addParameterListener(ParameterIds::PartPolyphonyId);
+    addParameterListener(ParameterIds::VoiceBudgetId);
+    
+    // Oversampling
+    addParameterListener(ParameterIds::OversamplingId);
+    addParameterListener(ParameterIds::OfflineOversamplingId);
+    
+    // Master limiter
+    addParameterListener(ParameterIds::LimiterLookaheadId);
+    
+    // Reverb
+    addParameterListener(ParameterIds::ReverbMixId);
+    addParameterListener(ParameterIds::ReverbDecayId);
+    addParameterListener(ParameterIds::ReverbDampingId);
+    
+    // Delay
+    addParameterListener(ParameterIds::DelayMixId);
+    addParameterListener(ParameterIds::DelaySyncId);
+    addParameterListener(ParameterIds::DelayDivisionId);
+    addParameterListener(ParameterIds::DelayTimeId);
+    addParameterListener(ParameterIds::DelayFeedbackId);
+    addParameterListener(ParameterIds::DelayToneId);
+    addParameterListener(ParameterIds::DelayPingPongId);
+    
+    // Chorus
+    addParameterListener(ParameterIds::ChorusMixId);
+    addParameterListener(ParameterIds::ChorusRateId);
+    addParameterListener(ParameterIds::ChorusDepthId);
+    addParameterListener(ParameterIds::ChorusTapsId);
+    
+    // Saturation
+    addParameterListener(ParameterIds::VoiceDriveId);
+    addParameterListener(ParameterIds::VoiceDriveShapeId);
+    addParameterListener(ParameterIds::BusDriveId);
+    addParameterListener(ParameterIds::BusDriveShapeId);
+    
+    // Convolution
+    addParameterListener(ParameterIds::ConvolutionEnabledId);
+    addParameterListener(ParameterIds::ConvolutionMixId);
+}
+
+void PluginProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    if (SessionLog::isPartParameter(parameterID))
+    {
+        const auto part = getPatchPart();
+        const auto index = SessionLog::getParameterIndex(parameterID);
+        if (index < 0)
+            return;
+        
+        _sessionRecorder.recordPartParameterChange(part, parameterID, newValue);
+        _partPatches[static_cast<size_t>(part)][static_cast<size_t>(index)].store(newValue);
+        applyPartParameter(part, index);
+        return;
+    }
+    
+    _sessionRecorder.recordParameterChange(parameterID, newValue);
+    
+    if (parameterID == ParameterIds::MultiTimbralId)
+    {
+        _engine.setMultiTimbral(newValue >= 0.5f);
+        _patchPartChanged.store(true);
+    }
+    else if (parameterID == ParameterIds::EditPartId)
+    {
+        _editPart.store(std::clamp(static_cast<int>(newValue) - 1, 0, MultiTimbralEngine::numParts - 1));
+        _patchPartChanged.store(true);
+    }
+    else if (parameterID == ParameterIds::VoiceBudgetId)
+    {
+        _engine.setVoiceBudget(static_cast<int>(newValue));
+    }
+    else if (parameterID == ParameterIds::OversamplingId ||
+             parameterID == ParameterIds::OfflineOversamplingId)
+    {
+        _engine.setOversampling(static_cast<EngineUtils::OversamplingFactor>(static_cast<int>(_audioProcessorValueTreeState.getRawParameterValue(ParameterIds::OversamplingId)->load())),
+                                static_cast<EngineUtils::OversamplingFactor>(static_cast<int>(_audioProcessorValueTreeState.getRawParameterValue(ParameterIds::OfflineOversamplingId)->load())));
+        _latencyChanged.store(true);
+    }
+    else if (parameterID == ParameterIds::LimiterLookaheadId)
+    {
+        _engine.setLimiterLookahead(newValue >= 0.5f);
+        _latencyChanged.store(true);
+    }
+    else if (parameterID == ParameterIds::ReverbMixId)
+    {
+        _engine.getReverb().setMix(newValue);
+    }
+    else if (parameterID == ParameterIds::ReverbDecayId)
+    {
+        _engine.getReverb().setDecay(newValue);
+    }
+    else if (parameterID == ParameterIds::ReverbDampingId)
+    {
+        _engine.getReverb().setDamping(newValue);
+    }
+    else if (parameterID == ParameterIds::DelayMixId)
+    {
+        _engine.getDelay().setMix(newValue);
+    }
+    else if (parameterID == ParameterIds::DelaySyncId)
+    {
+        _engine.getDelay().setSync(newValue >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::DelayDivisionId)
+    {
+        _engine.getDelay().setDivision(static_cast<int>(newValue));
+    }
+    else if (parameterID == ParameterIds::DelayTimeId)
+    {
+        _engine.getDelay().setTime(newValue);
+    }
+    else if (parameterID == ParameterIds::DelayFeedbackId)
+    {
+        _engine.getDelay().setFeedback(newValue);
+    }
+    else if (parameterID == ParameterIds::DelayToneId)
+    {
+        _engine.getDelay().setTone(newValue);
+    }
+    else if (parameterID == ParameterIds::DelayPingPongId)
+    {
+        _engine.getDelay().setPingPong(newValue >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::ChorusMixId)
+    {
+        _engine.getChorus().setMix(newValue);
+    }
+    else if (parameterID == ParameterIds::ChorusRateId)
+    {
+        _engine.getChorus().setRate(newValue);
+    }
+    else if (parameterID == ParameterIds::ChorusDepthId)
+    {
+        _engine.getChorus().setDepth(newValue);
+    }
+    else if (parameterID == ParameterIds::ChorusTapsId)
+    {
+        _engine.getChorus().setNumTaps(static_cast<int>(newValue));
+    }
+    else if (parameterID == ParameterIds::BusDriveId ||
+             parameterID == ParameterIds::BusDriveShapeId)
+    {
+        _engine.setBusDrive(_audioProcessorValueTreeState.getRawParameterValue(ParameterIds::BusDriveId)->load(),
+                            static_cast<EngineUtils::SaturationShape>(static_cast<int>(_audioProcessorValueTreeState.getRawParameterValue(ParameterIds::BusDriveShapeId)->load())));
+    }
+    else if (parameterID == ParameterIds::ConvolutionEnabledId)
+    {
+        _engine.getConvolver().setEnabled(newValue >= 0.5f);
+        _latencyChanged.store(true);
+    }
+    else if (parameterID == ParameterIds::ConvolutionMixId)
+    {
+        _engine.getConvolver().setMix(newValue);
+    }
+}
+
+// Outside multi-timbral mode the part parameters always edit part 1, the only part heard
+int PluginProcessor::getPatchPart() const
+{
+    return _engine.isMultiTimbral() ? _editPart.load() : 0;
+}
+
+float PluginProcessor::getPartValue(int part, const char* parameterID) const
+{
+    return _partPatches[static_cast<size_t>(part)][static_cast<size_t>(SessionLog::getParameterIndex(parameterID))].load();
+}
+
+void PluginProcessor::applyPartParameter(int part, int index)
+{
+    using WaveType = OscillatorUtils::WaveType;
+    
+    auto& engine = _engine.getPart(part);
+    const juce::String parameterID = ParameterIds::parameterIds[index];
+    const auto value = _partPatches[static_cast<size_t>(part)][static_cast<size_t>(index)].load();
+    
+    if (parameterID == ParameterIds::OscillatorATypeId)
+    {
+        engine.setOscillatorAType(static_cast<WaveType>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::OscillatorBTypeId)
+    {
+        engine.setOscillatorBType(static_cast<WaveType>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::OscillatorSubTypeId)
+    {
+        engine.setOscillatorSubType(static_cast<WaveType>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::OscillatorAGainId)
+    {
+        engine.setOscillatorAGain(value);
+    }
+    else if (parameterID == ParameterIds::OscillatorBGainId)
+    {
+        engine.setOscillatorBGain(value);
+    }
+    else if (parameterID == ParameterIds::OscillatorSubGainId)
+    {
+        engine.setOscillatorSubGain(value);
+    }
+    else if (parameterID == ParameterIds::AmplitudeEnvelopeAttackId ||
+             parameterID == ParameterIds::AmplitudeEnvelopeDecayId ||
+             parameterID == ParameterIds::AmplitudeEnvelopeSustainId ||
+             parameterID == ParameterIds::AmplitudeEnvelopeReleaseId)
+    {
+        auto p = juce::ADSR::Parameters{
+            getPartValue(part, ParameterIds::AmplitudeEnvelopeAttackId),
+            getPartValue(part, ParameterIds::AmplitudeEnvelopeDecayId),
+            getPartValue(part, ParameterIds::AmplitudeEnvelopeSustainId),
+            getPartValue(part, ParameterIds::AmplitudeEnvelopeReleaseId)
+        };
+        
+        engine.setAmplitudeEnvelopeParams(p);
+    }
+    else if (parameterID == ParameterIds::ModulationEnvelopeAttackId ||
+             parameterID == ParameterIds::ModulationEnvelopeDecayId ||
+             parameterID == ParameterIds::ModulationEnvelopeSustainId ||
+             parameterID == ParameterIds::ModulationEnvelopeReleaseId)
+    {
+        auto p = juce::ADSR::Parameters{
+            getPartValue(part, ParameterIds::ModulationEnvelopeAttackId),
+            getPartValue(part, ParameterIds::ModulationEnvelopeDecayId),
+            getPartValue(part, ParameterIds::ModulationEnvelopeSustainId),
+            getPartValue(part, ParameterIds::ModulationEnvelopeReleaseId)
+        };
+        
+        engine.setModulationEnvelopeParams(p);
+    }
+    else if (parameterID == ParameterIds::MasterGainId)
+    {
+        engine.setMasterGain(value);
+    }
+    else if (parameterID == ParameterIds::PlayModeId)
+    {
+        engine.requestPlayModeChange(static_cast<EngineUtils::PlayMode>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::NotePriorityId)
+    {
+        engine.setNotePriority(static_cast<EngineUtils::NotePriority>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::LegatoId)
+    {
+        engine.setLegato(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::GlideTimeId ||
+             parameterID == ParameterIds::GlideModeId)
+    {
+        engine.setGlide(getPartValue(part, ParameterIds::GlideTimeId),
+                        static_cast<EngineUtils::GlideMode>(static_cast<int>(getPartValue(part, ParameterIds::GlideModeId))));
+    }
+    else if (parameterID == ParameterIds::VoiceDriveId ||
+             parameterID == ParameterIds::VoiceDriveShapeId)
+    {
+        engine.setVoiceDrive(getPartValue(part, ParameterIds::VoiceDriveId),
+                             static_cast<EngineUtils::SaturationShape>(static_cast<int>(getPartValue(part, ParameterIds::VoiceDriveShapeId))));
+    }
+    else if (parameterID == ParameterIds::MpeEnabledId)
+    {
+        engine.setMpeEnabled(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::MpePitchBendRangeId)
+    {
+        engine.setMpePitchBendRange(value);
+    }
+    else if (parameterID == ParameterIds::PartPolyphonyId)
+    {
+        _engine.setPartPolyphony(part, static_cast<int>(value));
+    }
+}
+
+void PluginProcessor::applyPartPatch(int part)
+{
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        if (SessionLog::isPartParameter(ParameterIds::parameterIds[i]))
+        {
+            applyPartParameter(part, i);
+        }
+    }
+}
+
+// The engine only hears about a parameter when it changes, so the defaults are pushed into it here
+void PluginProcessor::applyParameters()
+{
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        const auto* parameterID = ParameterIds::parameterIds[i];
+        if (!SessionLog::isPartParameter(parameterID))
+        {
+            parameterChanged(parameterID, _audioProcessorValueTreeState.getRawParameterValue(parameterID)->load());
+        }
+    }
+    
+    for (auto part = 0; part < MultiTimbralEngine::numParts; ++part)
+    {
+        applyPartPatch(part);
+    }
+}
+
+// Shows the edited part's patch on the part parameters after the part or mode changes
+void PluginProcessor::showPatchPart()
+{
+    const auto part = getPatchPart();
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        const auto* parameterID = ParameterIds::parameterIds[i];
+        if (!SessionLog::isPartParameter(parameterID))
+            continue;
+        
+        if (auto* parameter = _audioProcessorValueTreeState.getParameter(parameterID))
+        {
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(_partPatches[static_cast<size_t>(part)][static_cast<size_t>(i)].load()));
+        }
+    }
+}
+
+void PluginProcessor::timerCallback()
+{
+    if (_patchPartChanged.exchange(false))
+    {
+        showPatchPart();
+    }
+    
+    if (_latencyChanged.exchange(false))
+    {
+        setLatencySamples(_engine.getLatencySamples());
+    }
+}
+
+
+const juce::String PluginProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool PluginProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool PluginProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool PluginProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double PluginProcessor::getTailLengthSeconds() const
+{
+    return _engine.getTailLengthSeconds();
+}
+
+int PluginProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int PluginProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void PluginProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String PluginProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void PluginProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void PluginProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    _sessionRecorder.recordPrepare(sampleRate, samplesPerBlock);
+    _engine.setNonRealtime(isNonRealtime());
+    _engine.prepareToPlay(sampleRate, samplesPerBlock);
+    setLatencySamples(_engine.getLatencySamples());
+    
+    // Master and oscillator gains
+    for (auto part = 0; part < MultiTimbralEngine::numParts; ++part)
+    {
+        auto& engine = _engine.getPart(part);
+        engine.setMasterGain(std::clamp(getPartValue(part, ParameterIds::MasterGainId), 0.0f, 1.0f));
+        engine.setOscillatorAGain(std::clamp(getPartValue(part, ParameterIds::OscillatorAGainId), 0.0f, 1.0f));
+        engine.setOscillatorBGain(std::clamp(getPartValue(part, ParameterIds::OscillatorBGainId), 0.0f, 1.0f));
+        engine.setOscillatorSubGain(std::clamp(getPartValue(part, ParameterIds::OscillatorSubGainId), 0.0f, 1.0f));
+    }
+}
+
+void PluginProcessor::releaseResources()
+{
+    _engine.reset();
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool PluginProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // In this template code we only support mono or stereo.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+void PluginProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    buffer.clear();
+    _sessionRecorder.recordBlock(buffer.getNumSamples(), midiMessages);
+    
+    // Without a tempo from the host the synced effects keep the last one they had
+    if (auto* playHead = getPlayHead())
+    {
+        if (const auto position = playHead->getPosition())
+        {
+            if (const auto bpm = position->getBpm())
+            {
+                _engine.setTempo(*bpm);
+            }
+        }
+    }
+    
+    _engine.processBlock(buffer, midiMessages);
+}
+
+// Hosts switch to offline rendering between blocks, never during one. The offline oversampling
+// factor can change the latency, so the host hears about it at the switch rather than mid-stream
+void PluginProcessor::setNonRealtime (bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    _engine.setNonRealtime(isNonRealtime);
+    setLatencySamples(_engine.getLatencySamples());
+}
+
+//==============================================================================
+bool PluginProcessor::startSessionCapture(const juce::File& logFile)
+{
+    // Seed the log with the current patch of every part so a replay starts from the same state
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        const auto* parameterID = ParameterIds::parameterIds[i];
+        if (!SessionLog::isPartParameter(parameterID))
+        {
+            _sessionRecorder.recordParameterChange(parameterID, _audioProcessorValueTreeState.getRawParameterValue(parameterID)->load());
+            continue;
+        }
+        
+        for (auto part = 0; part < MultiTimbralEngine::numParts; ++part)
+        {
+            _sessionRecorder.recordPartParameterChange(part, parameterID, _partPatches[static_cast<size_t>(part)][static_cast<size_t>(i)].load());
+        }
+    }
+    
+    return _sessionRecorder.start(logFile);
+}
+
+void PluginProcessor::stopSessionCapture()
+{
+    _sessionRecorder.stop();
+}
+
+bool PluginProcessor::isCapturingSession() const
+{
+    return _sessionRecorder.isRecording();
+}
+
+//==============================================================================
+bool PluginProcessor::loadTuning(const juce::File& scaleFile, const juce::File& keyboardMappingFile)
+{
+    // Keep the current pitch bend range, only the note frequencies change
+    auto tuning = std::make_unique<TuningTable>(_engine.getTuning());
+    if (!tuning->loadScalaFiles(scaleFile, keyboardMappingFile))
+        return false;
+    
+    _engine.setTuning(*tuning);
+    _audioProcessorValueTreeState.state.setProperty(_tuningScaleFileProperty, scaleFile.getFullPathName(), nullptr);
+    _audioProcessorValueTreeState.state.setProperty(_tuningKeyboardMappingFileProperty, keyboardMappingFile.getFullPathName(), nullptr);
+    return true;
+}
+
+void PluginProcessor::resetTuning()
+{
+    auto tuning = std::make_unique<TuningTable>(_engine.getTuning());
+    tuning->resetToEqualTemperament();
+    
+    _engine.setTuning(*tuning);
+    _audioProcessorValueTreeState.state.removeProperty(_tuningScaleFileProperty, nullptr);
+    _audioProcessorValueTreeState.state.removeProperty(_tuningKeyboardMappingFileProperty, nullptr);
+}
+
+bool PluginProcessor::loadImpulseResponse(const juce::File& file)
+{
+    // The file is read in the background, a bad one leaves the current response playing
+    if (!_engine.getConvolver().loadImpulseResponse(file))
+        return false;
+    
+    _audioProcessorValueTreeState.state.setProperty(_impulseResponseFileProperty, file.getFullPathName(), nullptr);
+    return true;
+}
+
+void PluginProcessor::clearImpulseResponse()
+{
+    _engine.getConvolver().clearImpulseResponse();
+    _audioProcessorValueTreeState.state.removeProperty(_impulseResponseFileProperty, nullptr);
+}
+
+bool PluginProcessor::loadSampleSet(const juce::File& folder)
+{
+    // Read in the background, a folder without usable samples leaves the current set playing
+    if (!_engine.getSampleStreamer().loadSampleSet(folder))
+        return false;
+    
+    _audioProcessorValueTreeState.state.setProperty(_sampleSetFolderProperty, folder.getFullPathName(), nullptr);
+    return true;
+}
+
+void PluginProcessor::clearSampleSet()
+{
+    _engine.getSampleStreamer().clearSampleSet();
+    _audioProcessorValueTreeState.state.removeProperty(_sampleSetFolderProperty, nullptr);
+}
+
+//==============================================================================
+bool PluginProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* PluginProcessor::createEditor()
+{
+    return new PluginEditor (*this);
+}
+
+//==============================================================================
+void PluginProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // Every part's patch is stored alongside the parameters, which only show the edited part
+    auto state = _audioProcessorValueTreeState.copyState();
+    for (auto i = state.getNumChildren(); --i >= 0;)
+    {
+        if (state.getChild(i).hasType(_partStateType))
+        {
+            state.removeChild(i, nullptr);
+        }
+    }
+    
+    for (auto part = 0; part < MultiTimbralEngine::numParts; ++part)
+    {
+        juce::ValueTree partState(_partStateType);
+        partState.setProperty(_partIndexProperty, part, nullptr);
+        for (auto i = 0; i < SessionLog::numParameters; ++i)
+        {
+            if (SessionLog::isPartParameter(ParameterIds::parameterIds[i]))
+            {
+                partState.setProperty(ParameterIds::parameterIds[i], _partPatches[static_cast<size_t>(part)][static_cast<size_t>(i)].load(), nullptr);
+            }
+        }
+        
+        state.appendChild(partState, nullptr);
+    }
+    
+    // Serialize tree to memory
+    juce::MemoryOutputStream stream(destData, true);
+    state.writeToStream(stream);
+}
+
+void PluginProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    auto stateTree = juce::ValueTree::readFromData(data, static_cast<size_t>(sizeInBytes));
+    if (stateTree.isValid() && stateTree.hasType(_audioProcessorValueTreeState.state.getType()))
+    {
+        _audioProcessorValueTreeState.replaceState(stateTree);
+        
+        for (const auto& partState : stateTree)
+        {
+            const int part = partState.getProperty(_partIndexProperty, -1);
+            if (!partState.hasType(_partStateType) || !juce::isPositiveAndBelow(part, MultiTimbralEngine::numParts))
+                continue;
+            
+            for (auto i = 0; i < SessionLog::numParameters; ++i)
+            {
+                if (partState.hasProperty(ParameterIds::parameterIds[i]))
+                {
+                    _partPatches[static_cast<size_t>(part)][static_cast<size_t>(i)].store(static_cast<float>(partState.getProperty(ParameterIds::parameterIds[i])));
+                }
+            }
+        }
+        
+        // The listener only fires for parameters the new state changed, so everything is pushed again
+        applyParameters();
+        _latencyChanged.store(false);
+        setLatencySamples(_engine.getLatencySamples());
+        
+        const auto scalePath = stateTree.getProperty(_tuningScaleFileProperty).toString();
+        if (scalePath.isEmpty() || !loadTuning(juce::File(scalePath), juce::File(stateTree.getProperty(_tuningKeyboardMappingFileProperty).toString())))
+        {
+            resetTuning();
+        }
+        
+        const auto impulseResponsePath = stateTree.getProperty(_impulseResponseFileProperty).toString();
+        if (impulseResponsePath.isEmpty() || !loadImpulseResponse(juce::File(impulseResponsePath)))
+        {
+            clearImpulseResponse();
+        }
+        
+        const auto sampleSetPath = stateTree.getProperty(_sampleSetFolderProperty).toString();
+        if (sampleSetPath.isEmpty() || !loadSampleSet(juce::File(sampleSetPath)))
+        {
+            clearSampleSet();
+        }
+    }
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new PluginProcessor();
+}
+
+SynthEngine& PluginProcessor::getSynthEngine() { return _engine.getPart(getPatchPart()); }
+juce::AudioProcessorValueTreeState& PluginProcessor::getAudioProcessorValueTreeState() {return _audioProcessorValueTreeState; }
@@ -1,73 +1,120 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "../Engine/SynthEngine.h"
-
-//==============================================================================
-/**
-*/
-class PluginProcessor  : public juce::AudioProcessor,
-                         public juce::AudioProcessorValueTreeState::Listener
-{
-public:
-    //==============================================================================
-    PluginProcessor();
-    ~PluginProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-    SynthEngine& getSynthEngine();
-    juce::AudioProcessorValueTreeState& getAudioProcessorValueTreeState();
-
-    void parameterChanged(const juce::String& parameterID, float newValue) override;
-    
-private:
-    SynthEngine _synthEngine;
-    juce::AudioProcessorValueTreeState _audioProcessorValueTreeState;
-    
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-    void initializeParameterListeners();
-    void addParameterListener(const juce::String& paramID);
-    std::vector<juce::String> getParameterIds() const;
-    static constexpr float _gainRampTimeInSeconds= 0.03f;
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Engine/MultiTimbralEngine.h"
+#include "../Session/SessionRecorder.h"
+
+//==============================================================================
+/**
+*/
+class PluginProcessor  : public juce::AudioProcessor,
+                         public juce::AudioProcessorValueTreeState::Listener,
+                         private juce::Timer
+{
+public:
+    //==============================================================================
+    PluginProcessor();
+    ~PluginProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void setNonRealtime (bool isNonRealtime) noexcept override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+    SynthEngine& getSynthEngine(); // The part the part parameters currently edit
+    juce::AudioProcessorValueTreeState& getAudioProcessorValueTreeState();
+
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    
+    // Session capture
+    bool startSessionCapture(const juce::File& logFile);
+    void stopSessionCapture();
+    bool isCapturingSession() const;
+    
+    // Tuning, stored with the plugin state as file paths
+    bool loadTuning(const juce::File& scaleFile, const juce::File& keyboardMappingFile);
+    void resetTuning();
+    
+    // Convolution response, also stored as a file path
+    bool loadImpulseResponse(const juce::File& file);
+    void clearImpulseResponse();
+    
+    // Samples for the Sample oscillator type, a folder with one file per root note
+    bool loadSampleSet(const juce::File& folder);
+    void clearSampleSet();
+    
+private:
+    MultiTimbralEngine _engine;
+    SessionRecorder _sessionRecorder;
+    juce::AudioProcessorValueTreeState _audioProcessorValueTreeState;
+    
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    void initializeParameterListeners();
+    void addParameterListener(const juce::String& paramID);
+    std::vector<juce::String> getParameterIds() const;
+    
+    // Multi-timbral parts. The part parameters show one part at a time, every part's values are kept here
+    std::array<std::array<std::atomic<float>, SessionLog::numParameters>, MultiTimbralEngine::numParts> _partPatches;
+    std::atomic<int> _editPart = 0;
+    
+    int getPatchPart() const;
+    float getPartValue(int part, const char* parameterID) const;
+    void applyPartParameter(int part, int index);
+    void applyPartPatch(int part);
+    void applyParameters();
+    void showPatchPart();
+    
+    // Parameter changes can arrive on the audio thread, the host and the other parameters
+    // are only told about them from the message thread
+    std::atomic<bool> _patchPartChanged = false;
+    std::atomic<bool> _latencyChanged = false;
+    void timerCallback() override;
+    
+    static constexpr float _gainRampTimeInSeconds= 0.03f;
+    static constexpr int _messageThreadUpdateMs = 50;
+    static constexpr const char* _sessionCaptureEnvironmentVariable = "SYNTH_SESSION_CAPTURE";
+    static constexpr const char* _tuningScaleFileProperty = "tuningScaleFile";
+    static constexpr const char* _tuningKeyboardMappingFileProperty = "tuningKeyboardMappingFile";
+    static constexpr const char* _impulseResponseFileProperty = "impulseResponseFile";
+    static constexpr const char* _sampleSetFolderProperty = "sampleSetFolder";
+    static constexpr const char* _partStateType = "Part";
+    static constexpr const char* _partIndexProperty = "index";
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginProcessor)
+};
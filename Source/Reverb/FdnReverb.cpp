@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    FdnReverb.cpp
+    Created: 22 Oct 2026 9:41:07am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "FdnReverb.h"
+
+void FdnReverb::prepare(double sampleRate)
+{
+    _sampleRate = sampleRate;
+    
+    // Line starts are rounded up to whole cache lines
+    constexpr auto floatsPerAlignment = _alignmentBytes / sizeof(float);
+    size_t arenaSize = 0;
+    _longestLine = 0;
+    for (auto line = 0; line < numLines; ++line)
+    {
+        const auto length = std::max(_maxSubBlock, juce::roundToInt(_lineMilliseconds[static_cast<size_t>(line)] * 0.001 * sampleRate));
+        _lineOffsets[static_cast<size_t>(line)] = arenaSize;
+        _lineLengths[static_cast<size_t>(line)] = length;
+        arenaSize += (static_cast<size_t>(length) + floatsPerAlignment - 1) / floatsPerAlignment * floatsPerAlignment;
+        _longestLine = std::max(_longestLine, length);
+    }
+    
+    _arena.assign(arenaSize + floatsPerAlignment, 0.0f);
+    void* start = _arena.data();
+    auto space = _arena.size() * sizeof(float);
+    _lines = static_cast<float*>(std::align(_alignmentBytes, arenaSize * sizeof(float), start, space));
+    
+    // Coefficients depend on the rate, so force them to be recalculated
+    _appliedMix = -1.0f;
+    _appliedDecay = -1.0f;
+    _appliedDamping = -1.0f;
+    _wetGain.reset(0.0f);
+    reset();
+}
+
+void FdnReverb::reset()
+{
+    clearLines();
+    _idleTracker.reset();
+}
+
+void FdnReverb::setMix(float mix)
+{
+    _mix.store(std::clamp(mix, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void FdnReverb::setDecay(float seconds)
+{
+    _decaySeconds.store(std::max(0.05f, seconds), std::memory_order_relaxed);
+}
+
+void FdnReverb::setDamping(float damping)
+{
+    _damping.store(std::clamp(damping, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void FdnReverb::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    if (_lines == nullptr)
+        return;
+    
+    updateParameters();
+    if (_wetGain.isSilent())
+    {
+        // Turned off, drop whatever tail is left so switching back on starts clean
+        if (!_idleTracker.isIdle())
+        {
+            reset();
+        }
+        
+        return;
+    }
+    
+    auto* left = buffer.getWritePointer(0);
+    auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : left;
+    
+    if (!_idleTracker.startBlock(IdleTracker::getPeak(buffer, 2, numSamples)))
+        return;
+    
+    auto tailPeak = 0.0f;
+    for (auto offset = 0; offset < numSamples; offset += _maxSubBlock)
+    {
+        const auto subBlockSize = std::min(_maxSubBlock, numSamples - offset);
+        tailPeak = std::max(tailPeak, processSubBlock(left + offset, right + offset, subBlockSize));
+        
+        // Add the wet signal, per sample only while the mix is ramping
+        auto* wetLeft = _wet[0].data();
+        auto* wetRight = _wet[1].data();
+        if (_wetGain.isRamping())
+        {
+            for (auto i = 0; i < subBlockSize; ++i)
+            {
+                const auto gain = _wetGain.getNextSample();
+                left[offset + i] += wetLeft[i] * gain;
+                if (right != left)
+                {
+                    right[offset + i] += wetRight[i] * gain;
+                }
+            }
+        }
+        else
+        {
+            const auto gain = _wetGain.getNextSample();
+            juce::FloatVectorOperations::addWithMultiply(left + offset, wetLeft, gain, subBlockSize);
+            if (right != left)
+            {
+                juce::FloatVectorOperations::addWithMultiply(right + offset, wetRight, gain, subBlockSize);
+            }
+        }
+    }
+    
+    // Every line has passed through the output once the longest has, so by then the tail is gone for good
+    if (_idleTracker.endBlock(numSamples, _longestLine, tailPeak))
+    {
+        clearLines();
+    }
+}
+
+bool FdnReverb::isIdle() const
+{
+    return _idleTracker.isIdle();
+}
+
+double FdnReverb::getTailLengthSeconds() const
+{
+    return _mix.load(std::memory_order_relaxed) > 0.0f ? static_cast<double>(_decaySeconds.load(std::memory_order_relaxed)) : 0.0;
+}
+
+void FdnReverb::updateParameters()
+{
+    const auto mix = _mix.load(std::memory_order_relaxed);
+    if (mix != _appliedMix)
+    {
+        _wetGain.setTargetGain(mix, _mixRampSeconds, _sampleRate);
+        _appliedMix = mix;
+    }
+    
+    // Each line loses 60dB over the decay time, scaled by how often it recirculates
+    const auto decay = _decaySeconds.load(std::memory_order_relaxed);
+    if (decay != _appliedDecay)
+    {
+        for (auto line = 0; line < numLines; ++line)
+        {
+            const auto lineSeconds = _lineLengths[static_cast<size_t>(line)] / _sampleRate;
+            _feedbackGains[static_cast<size_t>(line)] = static_cast<float>(std::pow(10.0, -3.0 * lineSeconds / decay));
+        }
+        
+        _appliedDecay = decay;
+    }
+    
+    // Full damping closes the lowpass down to about 800Hz
+    const auto damping = _damping.load(std::memory_order_relaxed);
+    if (damping != _appliedDamping)
+    {
+        const auto cutoff = std::min(20000.0 * std::pow(0.04, static_cast<double>(damping)), 0.45 * _sampleRate);
+        _dampingCoefficient = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * cutoff / _sampleRate));
+        _appliedDamping = damping;
+    }
+}
+
+// Runs the network for one sub-block into _wet and returns the peak left in the lines
+float FdnReverb::processSubBlock(const float* left, const float* right, int numSamples)
+{
+    jassert(numSamples <= _maxSubBlock);
+    
+    auto peak = 0.0f;
+    for (auto line = 0; line < numLines; ++line)
+    {
+        const auto index = static_cast<size_t>(line);
+        auto* signal = _lineSignals[index].data();
+        
+        // The oldest samples in each ring come due now, read in at most two pieces
+        const auto* ring = _lines + _lineOffsets[index];
+        const auto position = _linePositions[index];
+        const auto firstPart = std::min(numSamples, _lineLengths[index] - position);
+        juce::FloatVectorOperations::copy(signal, ring + position, firstPart);
+        juce::FloatVectorOperations::copy(signal + firstPart, ring, numSamples - firstPart);
+        
+        // Absorption
+        auto state = _dampingStates[index];
+        const auto gain = _feedbackGains[index];
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            state += _dampingCoefficient * (signal[i] - state);
+            signal[i] = state * gain;
+        }
+        
+        _dampingStates[index] = state;
+        
+        const auto range = juce::FloatVectorOperations::findMinAndMax(signal, numSamples);
+        peak = std::max({ peak, -range.getStart(), range.getEnd() });
+    }
+    
+    // Even lines feed the left output and odd lines the right, alternating signs keep them apart
+    juce::FloatVectorOperations::clear(_wet[0].data(), numSamples);
+    juce::FloatVectorOperations::clear(_wet[1].data(), numSamples);
+    for (auto line = 0; line < numLines; ++line)
+    {
+        auto* wet = _wet[static_cast<size_t>(line % 2)].data();
+        const auto* signal = _lineSignals[static_cast<size_t>(line)].data();
+        if ((line / 2) % 2 == 0)
+        {
+            juce::FloatVectorOperations::add(wet, signal, numSamples);
+        }
+        else
+        {
+            juce::FloatVectorOperations::subtract(wet, signal, numSamples);
+        }
+    }
+    
+    // Householder feedback, I - 2/N * ones: each line keeps its signal minus 2/N of the sum of all of them
+    juce::FloatVectorOperations::copy(_lineSum.data(), _lineSignals[0].data(), numSamples);
+    for (auto line = 1; line < numLines; ++line)
+    {
+        juce::FloatVectorOperations::add(_lineSum.data(), _lineSignals[static_cast<size_t>(line)].data(), numSamples);
+    }
+    
+    constexpr auto householderScale = -2.0f / static_cast<float>(numLines);
+    for (auto line = 0; line < numLines; ++line)
+    {
+        const auto index = static_cast<size_t>(line);
+        auto* signal = _lineSignals[index].data();
+        juce::FloatVectorOperations::addWithMultiply(signal, _lineSum.data(), householderScale, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(signal, line % 2 == 0 ? left : right, _inputGain, numSamples);
+        
+        // Write back over the samples just read
+        auto* ring = _lines + _lineOffsets[index];
+        const auto position = _linePositions[index];
+        const auto firstPart = std::min(numSamples, _lineLengths[index] - position);
+        juce::FloatVectorOperations::copy(ring + position, signal, firstPart);
+        juce::FloatVectorOperations::copy(ring, signal + firstPart, numSamples - firstPart);
+        _linePositions[index] = (position + numSamples) % _lineLengths[index];
+    }
+    
+    return peak;
+}
+
+void FdnReverb::clearLines()
+{
+    std::fill(_arena.begin(), _arena.end(), 0.0f);
+    _linePositions.fill(0);
+    _dampingStates.fill(0.0f);
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    FdnReverb.h
+    Created: 22 Oct 2026 9:41:07am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Gain/Gain.h"
+#include "../Utils/IdleTracker.h"
+
+// Feedback delay network reverb for the summed bus. Eight delay lines share one
+// cache-aligned arena and feed back through a Householder matrix, which only needs the
+// sum of the lines. Work is done in sub-blocks shorter than the shortest line, so
+// every step is a vector operation across a whole sub-block. The wet signal is added
+// to the dry input. Once the input and the tail are both silent, the reverb goes idle.
+class FdnReverb
+{
+public:
+    static constexpr int numLines = 8;
+    
+    FdnReverb() = default;
+    
+    void prepare(double sampleRate);
+    void reset();
+    
+    // Message thread
+    void setMix(float mix);
+    void setDecay(float seconds);
+    void setDamping(float damping);
+    
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+    bool isIdle() const;
+    double getTailLengthSeconds() const;
+    
+private:
+    static constexpr int _maxSubBlock = 64;
+    static constexpr size_t _alignmentBytes = 64; // One cache line
+    static constexpr std::array<double, numLines> _lineMilliseconds { 31.3, 37.1, 41.9, 47.3, 53.9, 59.1, 67.7, 73.3 };
+    static constexpr float _inputGain = 0.25f;
+    static constexpr float _mixRampSeconds = 0.05f;
+    
+    // Delay lines, each a ring exactly as long as its delay so reads and writes share a position
+    std::vector<float> _arena;
+    float* _lines = nullptr;
+    std::array<size_t, numLines> _lineOffsets {};
+    std::array<int, numLines> _lineLengths {};
+    std::array<int, numLines> _linePositions {};
+    int _longestLine = 0;
+    
+    // Absorption per line: a damping lowpass and the gain that gives the decay time
+    std::array<float, numLines> _feedbackGains {};
+    std::array<float, numLines> _dampingStates {};
+    float _dampingCoefficient = 1.0f;
+    
+    alignas(_alignmentBytes) std::array<std::array<float, _maxSubBlock>, numLines> _lineSignals {};
+    alignas(_alignmentBytes) std::array<float, _maxSubBlock> _lineSum {};
+    alignas(_alignmentBytes) std::array<std::array<float, _maxSubBlock>, 2> _wet {};
+    
+    double _sampleRate = 44100.0;
+    Gain _wetGain;
+    IdleTracker _idleTracker;
+    
+    std::atomic<float> _mix = 0.0f;
+    std::atomic<float> _decaySeconds = 2.0f;
+    std::atomic<float> _damping = 0.5f;
+    float _appliedMix = -1.0f;
+    float _appliedDecay = -1.0f;
+    float _appliedDamping = -1.0f;
+    
+    // Helpers
+    void updateParameters();
+    float processSubBlock(const float* left, const float* right, int numSamples);
+    void clearLines();
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FdnReverb)
+};
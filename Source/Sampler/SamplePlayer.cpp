@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+    
+    SamplePlayer.cpp
+    Created: 25 Oct 2026 4:26:10pm
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#include "SamplePlayer.h"
+
+void SamplePlayer::setStreamer(SampleStreamer* streamer)
+{
+    stopNote();
+    _streamer = streamer;
+}
+
+void SamplePlayer::setFrequency(float frequency, float sampleRate)
+{
+    _frequency = frequency;
+    _sampleRate = sampleRate;
+    updateIncrement();
+}
+
+void SamplePlayer::startNote(int midiNote)
+{
+    stopNote();
+    if (_streamer == nullptr || _streamer->getSampleSet() == nullptr)
+        return;
+    
+    _zone = _streamer->getSampleSet()->findZone(midiNote);
+    if (_zone == nullptr)
+        return;
+    
+    _setGeneration = _streamer->getSetGeneration();
+    
+    // Samples that fit in the preload never need a stream
+    if (_zone->length > static_cast<int64_t>(_zone->preload.size()))
+    {
+        _stream = _streamer->claimStream(*_zone, _streamClaim);
+    }
+    
+    _sourcePosition = 0;
+    _stagedCount = 0;
+    _stagedIndex = 0;
+    _fraction = 0.0;
+    _currentSample = nextSourceSample();
+    _nextSample = nextSourceSample();
+    updateIncrement();
+}
+
+void SamplePlayer::stopNote()
+{
+    if (_streamer != nullptr)
+    {
+        _streamer->releaseStream(_stream, _streamClaim);
+    }
+    
+    _stream = nullptr;
+    _zone = nullptr;
+    _currentSample = 0.0f;
+    _nextSample = 0.0f;
+}
+
+void SamplePlayer::processBlock(float* output, int numSamples)
+{
+    if (!isZoneValid())
+    {
+        _zone = nullptr;
+        juce::FloatVectorOperations::clear(output, numSamples);
+        return;
+    }
+    
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        output[i] = _currentSample + static_cast<float>(_fraction) * (_nextSample - _currentSample);
+        _fraction += _increment;
+        while (_fraction >= 1.0)
+        {
+            _fraction -= 1.0;
+            _currentSample = _nextSample;
+            _nextSample = nextSourceSample();
+        }
+    }
+}
+
+// A silent oscillator still has to keep its place, and keep its stream draining
+void SamplePlayer::advance(int numSamples)
+{
+    std::array<float, _advanceBlockSize> discarded;
+    while (_zone != nullptr && numSamples > 0)
+    {
+        const auto blockSize = std::min(numSamples, _advanceBlockSize);
+        processBlock(discarded.data(), blockSize);
+        numSamples -= blockSize;
+    }
+}
+
+// Swapping the set frees its zones, so a note started on an older set can't touch its zone again
+bool SamplePlayer::isZoneValid() const
+{
+    return _zone != nullptr && _streamer != nullptr && _streamer->getSetGeneration() == _setGeneration;
+}
+
+float SamplePlayer::nextSourceSample()
+{
+    if (_stagedIndex == _stagedCount)
+    {
+        stage();
+        if (_stagedCount == 0)
+            return 0.0f;
+    }
+    
+    return _staged[static_cast<size_t>(_stagedIndex++)];
+}
+
+void SamplePlayer::stage()
+{
+    _stagedIndex = 0;
+    _stagedCount = 0;
+    
+    const auto preloadLength = static_cast<int64_t>(_zone->preload.size());
+    const auto wanted = static_cast<int>(std::min(static_cast<int64_t>(_stagingSize), _zone->length - _sourcePosition));
+    if (wanted <= 0)
+    {
+        // Played to the end, the stream can go back to the pool
+        if (_stream != nullptr)
+        {
+            _streamer->releaseStream(_stream, _streamClaim);
+            _stream = nullptr;
+        }
+        
+        return;
+    }
+    
+    if (_sourcePosition < preloadLength)
+    {
+        _stagedCount = static_cast<int>(std::min(static_cast<int64_t>(wanted), preloadLength - _sourcePosition));
+        juce::FloatVectorOperations::copy(_staged.data(), _zone->preload.data() + _sourcePosition, _stagedCount);
+    }
+    else if (_streamer->isStreamCurrent(_stream, _streamClaim))
+    {
+        _stagedCount = _stream->read(_staged.data(), wanted);
+        if (_stagedCount < wanted)
+        {
+            _streamer->reportUnderrun();
+        }
+    }
+    
+    _sourcePosition += _stagedCount;
+}
+
+void SamplePlayer::updateIncrement()
+{
+    // Source samples per output sample, the zone's rate and the oscillator's may differ
+    _increment = _zone != nullptr && _sampleRate > 0.0f
+        ? std::min(_maxIncrement, static_cast<double>(_frequency) / _zone->rootFrequency * _zone->sampleRate / _sampleRate)
+        : 0.0;
+}
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+    
+    SamplePlayer.h
+    Created: 25 Oct 2026 4:26:10pm
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SampleStreamer.h"
+
+// Plays one zone of the streamer's sample set at the oscillator's frequency, with linear
+// interpolation. Source samples are staged a few at a time, from the preload while it
+// lasts and then from a stream. If no stream is free only the preload is heard, and if
+// the stream runs dry the note drops out until it catches up.
+class SamplePlayer
+{
+public:
+    SamplePlayer() = default;
+    
+    void setStreamer(SampleStreamer* streamer);
+    void setFrequency(float frequency, float sampleRate);
+    
+    // Audio thread
+    void startNote(int midiNote);
+    void stopNote();
+    void processBlock(float* output, int numSamples);
+    void advance(int numSamples);
+
+private:
+    static constexpr int _stagingSize = 64;
+    static constexpr int _advanceBlockSize = 64;
+    static constexpr double _maxIncrement = 8.0; // Three octaves above the root, further up would outrun the stream
+    
+    SampleStreamer* _streamer = nullptr; // Owned by the engine
+    const SampleSet::Zone* _zone = nullptr;
+    int _setGeneration = 0;
+    SampleStreamer::Stream* _stream = nullptr;
+    int _streamClaim = 0;
+    
+    int64_t _sourcePosition = 0; // Next source sample to stage
+    std::array<float, _stagingSize> _staged {};
+    int _stagedCount = 0;
+    int _stagedIndex = 0;
+    
+    // Output sits between these two source samples
+    float _currentSample = 0.0f;
+    float _nextSample = 0.0f;
+    double _fraction = 0.0;
+    double _increment = 0.0;
+    float _frequency = 0.0f;
+    float _sampleRate = 44100.0f;
+    
+    // Helpers
+    bool isZoneValid() const;
+    float nextSourceSample();
+    void stage();
+    void updateIncrement();
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplePlayer)
+};
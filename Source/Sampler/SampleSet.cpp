@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+    
+    SampleSet.cpp
+    Created: 25 Oct 2026 2:14:37pm
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#include "SampleSet.h"
+#include "../Utils/MidiUtils.h"
+
+std::unique_ptr<SampleSet> SampleSet::loadFromFolder(const juce::File& folder)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    
+    auto set = std::make_unique<SampleSet>();
+    juce::AudioBuffer<float> scratch;
+    for (const auto& file : folder.findChildFiles(juce::File::findFiles, false, formatManager.getWildcardForAllFormats()))
+    {
+        // The root note is the last word of the name. Words only split on spaces and
+        // underscores, a dash belongs to the octave as in "Piano_Bb-1"
+        const auto name = file.getFileNameWithoutExtension().trim();
+        const auto rootNote = MidiUtils::getMidiNoteFromName(name.fromLastOccurrenceOf(" ", false, false)
+                                                                 .fromLastOccurrenceOf("_", false, false)
+                                                                 .toStdString());
+        if (rootNote < 0)
+            continue;
+        
+        auto reader = openReader(formatManager, file);
+        if (reader == nullptr || reader->sampleRate <= 0.0 || reader->numChannels == 0 || reader->lengthInSamples <= 0)
+            continue;
+        
+        Zone zone;
+        zone.rootNote = rootNote;
+        zone.rootFrequency = MidiUtils::getMidiNoteInHertz(rootNote);
+        zone.sampleRate = reader->sampleRate;
+        zone.length = reader->lengthInSamples;
+        
+        // Stereo files are summed to mono, the voices are mono
+        const auto numChannels = std::min(static_cast<int>(reader->numChannels), 2);
+        const auto preloadLength = static_cast<int>(std::min(zone.length, static_cast<int64_t>(preloadSeconds * reader->sampleRate)));
+        scratch.setSize(numChannels, preloadLength, false, false, true);
+        reader->read(&scratch, 0, preloadLength, 0, true, numChannels > 1);
+        
+        zone.preload.assign(static_cast<size_t>(preloadLength), 0.0f);
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            juce::FloatVectorOperations::addWithMultiply(zone.preload.data(), scratch.getReadPointer(channel), 1.0f / static_cast<float>(numChannels), preloadLength);
+        }
+        
+        zone.reader = std::move(reader);
+        set->_zones.push_back(std::move(zone));
+    }
+    
+    if (set->_zones.empty())
+        return nullptr;
+    
+    // A second file on the same root would never be heard
+    std::stable_sort(set->_zones.begin(), set->_zones.end(), [](const Zone& a, const Zone& b) { return a.rootNote < b.rootNote; });
+    set->_zones.erase(std::unique(set->_zones.begin(), set->_zones.end(), [](const Zone& a, const Zone& b) { return a.rootNote == b.rootNote; }), set->_zones.end());
+    set->mapKeys();
+    return set;
+}
+
+const SampleSet::Zone* SampleSet::findZone(int midiNote) const
+{
+    if (_zones.empty() || midiNote < 0 || midiNote >= static_cast<int>(_noteZones.size()))
+        return nullptr;
+    
+    return &_zones[static_cast<size_t>(_noteZones[static_cast<size_t>(midiNote)])];
+}
+
+int SampleSet::getNumZones() const
+{
+    return static_cast<int>(_zones.size());
+}
+
+std::unique_ptr<juce::AudioFormatReader> SampleSet::openReader(juce::AudioFormatManager& formatManager, const juce::File& file)
+{
+    // Pages of a mapped file are only read in when the streaming thread touches them
+    if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+    {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(format->createMemoryMappedReader(file));
+        if (mappedReader != nullptr && mappedReader->mapEntireFile())
+            return mappedReader;
+    }
+    
+    // Compressed formats can't be mapped and are decoded as they stream instead
+    return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+}
+
+// Keys go to the nearest root, halfway between two roots goes to the upper one so the sample is pitched down
+void SampleSet::mapKeys()
+{
+    auto zone = 0;
+    for (auto note = 0; note < static_cast<int>(_noteZones.size()); ++note)
+    {
+        while (zone + 1 < static_cast<int>(_zones.size())
+               && note - _zones[static_cast<size_t>(zone)].rootNote >= _zones[static_cast<size_t>(zone + 1)].rootNote - note)
+        {
+            ++zone;
+        }
+        
+        _noteZones[static_cast<size_t>(note)] = zone;
+    }
+}
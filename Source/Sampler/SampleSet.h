@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+    
+    SampleSet.h
+    Created: 25 Oct 2026 2:14:37pm
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// A folder of samples spread across the keyboard. Each file's root note comes from the
+// end of its name ("Piano_C4.wav", "Bass 36.aif") and every key plays the zone with the
+// nearest root. Only the first moments of each file are held in memory, which covers the
+// start of a note while SampleStreamer fetches the rest from disk. Files are memory-mapped
+// where the format allows it, so a large set costs address space rather than RAM.
+class SampleSet
+{
+public:
+    static constexpr double preloadSeconds = 0.25;
+    
+    struct Zone
+    {
+        int rootNote = 60;
+        float rootFrequency = 261.63f;
+        double sampleRate = 44100.0;
+        int64_t length = 0; // Whole file, in samples
+        std::vector<float> preload; // Mono, the first preloadSeconds of the file
+        std::unique_ptr<juce::AudioFormatReader> reader; // Only used by the streaming thread once loaded
+    };
+    
+    SampleSet() = default;
+    
+    // Loader thread, returns nullptr if the folder holds no usable samples
+    static std::unique_ptr<SampleSet> loadFromFolder(const juce::File& folder);
+    
+    // Audio thread
+    const Zone* findZone(int midiNote) const;
+    int getNumZones() const;
+
+private:
+    std::vector<Zone> _zones; // Sorted by root note
+    std::array<int, 128> _noteZones {}; // Zone index per key
+    
+    static std::unique_ptr<juce::AudioFormatReader> openReader(juce::AudioFormatManager& formatManager, const juce::File& file);
+    void mapKeys();
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleSet)
+};
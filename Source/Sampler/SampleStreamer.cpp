@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+    
+    SampleStreamer.cpp
+    Created: 25 Oct 2026 3:02:51pm
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#include "SampleStreamer.h"
+
+SampleStreamer::Stream::Stream()
+    : _ring(static_cast<size_t>(_ringSize), 0.0f)
+{
+}
+
+int SampleStreamer::Stream::read(float* destination, int numSamples)
+{
+    int start1, size1, start2, size2;
+    _fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+    juce::FloatVectorOperations::copy(destination, _ring.data() + start1, size1);
+    juce::FloatVectorOperations::copy(destination + size1, _ring.data() + start2, size2);
+    _fifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+SampleStreamer::SampleStreamer()
+    : juce::Thread("Sample Streamer")
+{
+    _readBuffer.setSize(2, _maxReadSize);
+}
+
+SampleStreamer::~SampleStreamer()
+{
+    _loader.removeAllJobs(true, 2000);
+    stopThread(1000);
+}
+
+void SampleStreamer::prepare()
+{
+    if (!isThreadRunning())
+    {
+        startThread(juce::Thread::Priority::high);
+    }
+}
+
+bool SampleStreamer::loadSampleSet(const juce::File& folder)
+{
+    if (!folder.isDirectory())
+        return false;
+    
+    _loader.addJob([this, folder]
+    {
+        if (auto set = SampleSet::loadFromFolder(folder))
+        {
+            _sets.publish(std::move(set));
+        }
+    });
+    
+    return true;
+}
+
+void SampleStreamer::clearSampleSet()
+{
+    // Queued behind any load still running, an empty set plays nothing
+    _loader.addJob([this]
+    {
+        _sets.publish(std::make_unique<SampleSet>());
+    });
+}
+
+int SampleStreamer::getNumUnderruns() const
+{
+    return _underruns.load(std::memory_order_relaxed);
+}
+
+void SampleStreamer::update()
+{
+    auto* set = _sets.takePending();
+    if (set == nullptr)
+        return;
+    
+    for (auto& stream : _streams)
+    {
+        if (stream._state.load(std::memory_order_relaxed) == Stream::playingStream)
+        {
+            ++stream._claim;
+            stream._state.store(Stream::releasedStream, std::memory_order_release);
+        }
+    }
+    
+    ++_setGeneration;
+    _sets.retire(_set.release());
+    _set.reset(set);
+}
+
+const SampleSet* SampleStreamer::getSampleSet() const
+{
+    return _set.get();
+}
+
+int SampleStreamer::getSetGeneration() const
+{
+    return _setGeneration;
+}
+
+SampleStreamer::Stream* SampleStreamer::claimStream(const SampleSet::Zone& zone, int& claim)
+{
+    for (auto& stream : _streams)
+    {
+        if (stream._state.load(std::memory_order_acquire) != Stream::freeStream)
+            continue;
+        
+        stream._zone = &zone;
+        stream._filePosition = static_cast<int64_t>(zone.preload.size());
+        claim = ++stream._claim;
+        stream._state.store(Stream::playingStream, std::memory_order_release);
+        return &stream;
+    }
+    
+    return nullptr;
+}
+
+void SampleStreamer::releaseStream(Stream* stream, int claim)
+{
+    if (!isStreamCurrent(stream, claim))
+        return;
+    
+    ++stream->_claim;
+    stream->_state.store(Stream::releasedStream, std::memory_order_release);
+}
+
+bool SampleStreamer::isStreamCurrent(const Stream* stream, int claim) const
+{
+    return stream != nullptr && stream->_claim == claim;
+}
+
+void SampleStreamer::reportUnderrun()
+{
+    _underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SampleStreamer::run()
+{
+    while (!threadShouldExit())
+    {
+        // Read before the streams, any stream still on a retired set is released by then
+        const auto hasRetiredSet = _sets.hasRetired();
+        for (auto& stream : _streams)
+        {
+            const auto state = stream._state.load(std::memory_order_acquire);
+            if (state == Stream::releasedStream)
+            {
+                stream._fifo.reset();
+                stream._zone = nullptr;
+                stream._state.store(Stream::freeStream, std::memory_order_release);
+            }
+            else if (state == Stream::playingStream)
+            {
+                fill(stream);
+            }
+        }
+        
+        if (hasRetiredSet)
+        {
+            _sets.freeRetired();
+        }
+        
+        wait(_pollIntervalMs);
+    }
+}
+
+void SampleStreamer::fill(Stream& stream)
+{
+    const auto& zone = *stream._zone;
+    const auto remaining = zone.length - stream._filePosition;
+    const auto numSamples = static_cast<int>(std::min({ remaining, static_cast<int64_t>(stream._fifo.getFreeSpace()), static_cast<int64_t>(_maxReadSize) }));
+    if (numSamples <= 0)
+        return;
+    
+    // Mapped readers page the file in here, on this thread rather than the audio thread. A
+    // failed read goes out as silence so the note keeps its place rather than play stale samples
+    const auto numChannels = std::min(static_cast<int>(zone.reader->numChannels), _readBuffer.getNumChannels());
+    if (!zone.reader->read(&_readBuffer, 0, numSamples, stream._filePosition, true, numChannels > 1))
+    {
+        _readBuffer.clear(0, numSamples);
+    }
+    
+    auto* samples = _readBuffer.getWritePointer(0);
+    if (numChannels > 1)
+    {
+        juce::FloatVectorOperations::add(samples, _readBuffer.getReadPointer(1), numSamples);
+        juce::FloatVectorOperations::multiply(samples, 0.5f, numSamples);
+    }
+    
+    int start1, size1, start2, size2;
+    stream._fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+    juce::FloatVectorOperations::copy(stream._ring.data() + start1, samples, size1);
+    juce::FloatVectorOperations::copy(stream._ring.data() + start2, samples + size1, size2);
+    stream._fifo.finishedWrite(size1 + size2);
+    stream._filePosition += size1 + size2;
+}
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+    
+    SampleStreamer.h
+    Created: 25 Oct 2026 3:02:51pm
+    Author:  Joshua Navon
+  
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SampleSet.h"
+#include "../Utils/AudioThreadHandover.h"
+
+// Streams the samples of the loaded SampleSet from disk for every part. A note plays the
+// zone's preload straight from memory while a stream picks up where the preload ends.
+// Streams come from a fixed pool, each with its own lock-free ring, and a background
+// thread keeps the rings topped up. The audio thread only claims, reads and releases
+// streams. New sets are loaded on a separate thread and swapped in at the start of a
+// block, which cuts off notes still playing the old set.
+class SampleStreamer : private juce::Thread
+{
+public:
+    static constexpr int numStreams = 64;
+    
+    // One note's read position in a zone, past the preload
+    class Stream
+    {
+    public:
+        Stream();
+        int read(float* destination, int numSamples); // Audio thread
+    
+    private:
+        friend class SampleStreamer;
+        
+        enum State
+        {
+            freeStream,
+            playingStream,
+            releasedStream
+        };
+        
+        static constexpr int _ringSize = 1 << 14;
+        
+        juce::AbstractFifo _fifo { _ringSize };
+        std::vector<float> _ring;
+        std::atomic<int> _state = freeStream;
+        const SampleSet::Zone* _zone = nullptr;
+        int64_t _filePosition = 0; // Streaming thread, the next sample to read
+        int _claim = 0; // Audio thread, bumped every time the stream changes hands
+    };
+    
+    SampleStreamer();
+    ~SampleStreamer() override;
+    
+    void prepare();
+    
+    // Message thread
+    bool loadSampleSet(const juce::File& folder);
+    void clearSampleSet();
+    int getNumUnderruns() const;
+    
+    // Audio thread
+    void update();
+    const SampleSet* getSampleSet() const;
+    int getSetGeneration() const; // Changes whenever a set is swapped, zones from older generations are gone
+    Stream* claimStream(const SampleSet::Zone& zone, int& claim);
+    void releaseStream(Stream* stream, int claim);
+    bool isStreamCurrent(const Stream* stream, int claim) const;
+    void reportUnderrun();
+
+private:
+    static constexpr int _maxReadSize = 4096; // Per stream and pass, so one note can't hold up the rest
+    static constexpr int _pollIntervalMs = 2;
+    
+    std::array<Stream, numStreams> _streams;
+    juce::AudioBuffer<float> _readBuffer; // Streaming thread
+    
+    // Sets are built on the loader thread and freed on the streaming thread, never on the audio thread
+    std::unique_ptr<SampleSet> _set;
+    AudioThreadHandover<SampleSet> _sets;
+    int _setGeneration = 0;
+    
+    juce::ThreadPool _loader { 1 };
+    std::atomic<int> _underruns = 0;
+    
+    // Helpers
+    void run() override;
+    void fill(Stream& stream);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleStreamer)
+};
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    Saturator.cpp
+    Created: 23 Oct 2026 4:27:52pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "Saturator.h"
+#include "../Utils/GainUtils.h"
+
+void Saturator::prepare(double sampleRate)
+{
+    _drive.reset(sampleRate, _driveRampSeconds);
+    _drive.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(_appliedAmount * _maxDriveDecibels));
+    _wet.reset(sampleRate, _driveRampSeconds);
+    _wet.setCurrentAndTargetValue(getWetLevel(_appliedAmount));
+    reset();
+}
+
+void Saturator::setSampleRate(double sampleRate)
+{
+    GainUtils::setSmoothedValueSampleRate(_drive, sampleRate, _driveRampSeconds);
+    GainUtils::setSmoothedValueSampleRate(_wet, sampleRate, _driveRampSeconds);
+}
+
+void Saturator::reset()
+{
+    _previousInput = 0.0;
+    _previousAntiderivative = getAntiderivative(0.0, _appliedShape);
+}
+
+void Saturator::setDrive(float amount)
+{
+    _amount.store(std::clamp(amount, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void Saturator::setShape(EngineUtils::SaturationShape shape)
+{
+    _shape.store(shape, std::memory_order_relaxed);
+}
+
+void Saturator::setInputLevel(float level)
+{
+    _inputLevel = std::max(level, 1.0e-3f);
+}
+
+void Saturator::processBlock(float* samples, int numSamples)
+{
+    const auto amount = _amount.load(std::memory_order_relaxed);
+    if (amount != _appliedAmount)
+    {
+        // Coming out of bypass starts from the new drive rather than gliding up from unity, the wet level fades it in
+        const auto drive = juce::Decibels::decibelsToGain(amount * _maxDriveDecibels);
+        if (isBypassed())
+        {
+            _drive.setCurrentAndTargetValue(drive);
+        }
+        else
+        {
+            _drive.setTargetValue(drive);
+        }
+        
+        _wet.setTargetValue(getWetLevel(amount));
+        _appliedAmount = amount;
+    }
+    
+    if (isBypassed())
+    {
+        if (!isSettled())
+        {
+            reset();
+        }
+        
+        return;
+    }
+    
+    const auto shape = _shape.load(std::memory_order_relaxed);
+    if (shape != _appliedShape)
+    {
+        _appliedShape = shape;
+        _previousAntiderivative = getAntiderivative(_previousInput, shape);
+    }
+    
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        // Drive pushes into the shape, and the square root of it comes back off so louder drive isn't all level.
+        // The input level is scaled to full scale on the way in and back on the way out
+        const auto dry = samples[i];
+        const auto drive = _drive.getNextValue();
+        const auto wet = _wet.getNextValue();
+        const auto input = static_cast<double>(dry * drive * _inputLevel);
+        const auto antiderivative = getAntiderivative(input, shape);
+        const auto difference = input - _previousInput;
+        
+        const auto output = std::abs(difference) > _flatThreshold
+            ? (antiderivative - _previousAntiderivative) / difference
+            : applyShape(0.5 * (input + _previousInput), shape);
+        
+        _previousInput = input;
+        _previousAntiderivative = antiderivative;
+        const auto shaped = static_cast<float>(output) / (std::sqrt(drive) * _inputLevel);
+        samples[i] = dry + wet * (shaped - dry);
+    }
+}
+
+bool Saturator::isBypassed() const
+{
+    return _appliedAmount == 0.0f && !_wet.isSmoothing();
+}
+
+float Saturator::getWetLevel(float amount)
+{
+    return std::min(1.0f, amount / _fullWetAmount);
+}
+
+bool Saturator::isSettled() const
+{
+    return _previousInput == 0.0;
+}
+
+double Saturator::applyShape(double x, EngineUtils::SaturationShape shape)
+{
+    switch (shape)
+    {
+        case EngineUtils::SaturationShape::HardClip:
+            return std::clamp(x, -1.0, 1.0);
+            
+        case EngineUtils::SaturationShape::Foldback:
+        {
+            // Triangle with period 4 that matches the input between -1 and 1
+            const auto phase = x + 1.0 - 4.0 * std::floor((x + 1.0) * 0.25);
+            return phase < 2.0 ? phase - 1.0 : 3.0 - phase;
+        }
+            
+        case EngineUtils::SaturationShape::Tanh:
+        default:
+            return std::tanh(x);
+    }
+}
+
+double Saturator::getAntiderivative(double x, EngineUtils::SaturationShape shape)
+{
+    switch (shape)
+    {
+        case EngineUtils::SaturationShape::HardClip:
+            return std::abs(x) <= 1.0 ? 0.5 * x * x : std::abs(x) - 0.5;
+            
+        case EngineUtils::SaturationShape::Foldback:
+        {
+            // The triangle integrates to zero over each period, so only the position within it matters
+            const auto phase = x + 1.0 - 4.0 * std::floor((x + 1.0) * 0.25);
+            if (phase < 2.0)
+                return 0.5 * phase * phase - phase;
+            
+            return 3.0 * (phase - 2.0) - 0.5 * (phase * phase - 4.0);
+        }
+            
+        case EngineUtils::SaturationShape::Tanh:
+        default:
+        {
+            // log(cosh(x)) written so large inputs don't overflow cosh
+            constexpr auto logOfTwo = 0.69314718055994531;
+            const auto magnitude = std::abs(x);
+            return magnitude + std::log1p(std::exp(-2.0 * magnitude)) - logOfTwo;
+        }
+    }
+}
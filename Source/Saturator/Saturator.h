@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    Saturator.h
+    Created: 23 Oct 2026 4:27:52pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Utils/EngineUtils.h"
+
+// Waveshaper for one channel with first-order antiderivative anti-aliasing. Instead of
+// shaping each sample, it outputs the average of the shape between consecutive inputs,
+// (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]) where F is the shape's antiderivative. That
+// suppresses most of the aliasing without oversampling, at the cost of a half-sample
+// delay. It is cheap enough to run per voice as well as on the bus. Drive and shape may
+// be set from any thread and are picked up at the start of the next block.
+class Saturator
+{
+public:
+    Saturator() = default;
+    
+    void prepare(double sampleRate);
+    void setSampleRate(double sampleRate); // Keeps the history and any drive ramp, for a voice changing rate mid-note
+    void reset();
+    
+    // Amount 0 bypasses, 1 drives the input by 36dB. Low amounts also blend the shaper in over the
+    // dry signal, so the sound doesn't jump as the amount leaves 0
+    void setDrive(float amount);
+    void setShape(EngineUtils::SaturationShape shape);
+    void setInputLevel(float level); // The input's full scale level, such as a voice's headroom in the mix. Set before processing
+    
+    void processBlock(float* samples, int numSamples);
+    bool isSettled() const; // Last input was zero, so silence in gives silence out
+    
+private:
+    static constexpr float _maxDriveDecibels = 36.0f;
+    static constexpr double _driveRampSeconds = 0.02;
+    static constexpr double _flatThreshold = 1.0e-5; // Closer inputs than this use the shape at their midpoint
+    static constexpr float _fullWetAmount = 0.25f; // Amounts from here up are all shaper
+    
+    std::atomic<float> _amount = 0.0f;
+    std::atomic<EngineUtils::SaturationShape> _shape = EngineUtils::SaturationShape::Tanh;
+    float _appliedAmount = 0.0f;
+    EngineUtils::SaturationShape _appliedShape = EngineUtils::SaturationShape::Tanh;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> _drive = 1.0f;
+    juce::SmoothedValue<float> _wet = 0.0f;
+    float _inputLevel = 1.0f;
+    
+    double _previousInput = 0.0;
+    double _previousAntiderivative = 0.0;
+    
+    // Helpers
+    bool isBypassed() const; // Amount 0 and the wet level faded out
+    static float getWetLevel(float amount);
+    static double applyShape(double x, EngineUtils::SaturationShape shape);
+    static double getAntiderivative(double x, EngineUtils::SaturationShape shape);
+};
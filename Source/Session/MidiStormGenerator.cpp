@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    MidiStormGenerator.cpp
+    Created: 18 Oct 2026 3:20:09pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "MidiStormGenerator.h"
+#include "SessionLog.h"
+#include "../Utils/EngineUtils.h"
+#include <JuceHeader.h>
+
+namespace
+{
+    constexpr float stormBlockProbability = 0.1f;
+    constexpr int quietBlockMaxEvents = 8;
+
+    // A patch with every oscillator audible and a release long enough to keep voices tailing
+    float getPatchValue(const juce::String& parameterID)
+    {
+        if (parameterID == ParameterIds::AmplitudeEnvelopeReleaseId || parameterID == ParameterIds::ModulationEnvelopeReleaseId)
+            return 0.5f;
+        if (parameterID == ParameterIds::AmplitudeEnvelopeDecayId || parameterID == ParameterIds::ModulationEnvelopeDecayId)
+            return 0.1f;
+        if (parameterID == ParameterIds::AmplitudeEnvelopeAttackId || parameterID == ParameterIds::ModulationEnvelopeAttackId)
+            return 0.0f;
+        if (parameterID == ParameterIds::MasterGainId)
+            return 0.8f;
+        if (parameterID == ParameterIds::OscillatorATypeId || parameterID == ParameterIds::OscillatorBTypeId || parameterID == ParameterIds::OscillatorSubTypeId)
+            return 0.0f;
+        if (parameterID == ParameterIds::PlayModeId)
+            return static_cast<float>(EngineUtils::PlayMode::Polyphonic);
+        if (parameterID == ParameterIds::NotePriorityId || parameterID == ParameterIds::GlideModeId)
+            return 0.0f;
+        if (parameterID == ParameterIds::GlideTimeId)
+            return 0.05f; // Short enough that mono blocks still see glides finish
+        if (parameterID == ParameterIds::MpeEnabledId)
+            return 0.0f;
+        if (parameterID == ParameterIds::MpePitchBendRangeId)
+            return 48.0f;
+        if (parameterID == ParameterIds::PartPolyphonyId)
+            return 8.0f;
+        if (parameterID == ParameterIds::VoiceBudgetId)
+            return 32.0f;
+        if (parameterID == ParameterIds::OversamplingId || parameterID == ParameterIds::OfflineOversamplingId)
+            return static_cast<float>(EngineUtils::OversamplingFactor::Off);
+        if (parameterID == ParameterIds::VoiceDriveId)
+            return 0.5f; // Keeps the per-voice shaper running through the storm
+        if (parameterID == ParameterIds::VoiceDriveShapeId)
+            return static_cast<float>(EngineUtils::SaturationShape::Tanh);
+        if (parameterID == ParameterIds::EditPartId || parameterID == ParameterIds::ChorusTapsId)
+            return 1.0f;
+        if (parameterID == ParameterIds::BusDriveId || parameterID == ParameterIds::BusDriveShapeId || parameterID == ParameterIds::ConvolutionEnabledId
+            || parameterID == ParameterIds::DelaySyncId || parameterID == ParameterIds::DelayDivisionId)
+            return 0.0f;
+        if (parameterID == ParameterIds::DelayTimeId)
+            return 375.0f;
+
+        // Bus effects half in, so their tails run under the storm too
+        if (parameterID == ParameterIds::ReverbMixId || parameterID == ParameterIds::ReverbDecayId || parameterID == ParameterIds::ReverbDampingId
+            || parameterID == ParameterIds::DelayMixId || parameterID == ParameterIds::DelayFeedbackId || parameterID == ParameterIds::DelayToneId
+            || parameterID == ParameterIds::ChorusMixId || parameterID == ParameterIds::ChorusRateId || parameterID == ParameterIds::ChorusDepthId)
+            return 0.5f;
+
+        return 1.0f; // Oscillator gains and sustain levels
+    }
+
+    SessionLog::Event makeMidiEvent(int position, uint8_t status, int data1, int data2)
+    {
+        SessionLog::Event event;
+        event.type = SessionLog::EventType::Midi;
+        event.numBytes = 3;
+        event.data[0] = status;
+        event.data[1] = static_cast<uint8_t>(data1 & 0x7f);
+        event.data[2] = static_cast<uint8_t>(data2 & 0x7f);
+        event.position = position;
+        return event;
+    }
+
+    void addStormEvents(juce::Random& random, int blockSize, int numEvents, int numChannels, std::vector<SessionLog::Event>& events)
+    {
+        constexpr uint8_t noteOn = 0x90;
+        constexpr uint8_t noteOff = 0x80;
+        constexpr uint8_t pitchWheel = 0xe0;
+        constexpr uint8_t controller = 0xb0;
+        constexpr int sustainPedal = 64;
+        constexpr int sostenutoPedal = 66;
+
+        for (auto i = 0; i < numEvents; ++i)
+        {
+            const auto position = random.nextInt(blockSize);
+            const auto note = random.nextInt(128);
+            const auto kind = random.nextFloat();
+            const auto channel = static_cast<uint8_t>(numChannels > 1 ? random.nextInt(numChannels) : 0);
+
+            if (kind < 0.35f)
+            {
+                events.push_back(makeMidiEvent(position, noteOn | channel, note, 1 + random.nextInt(127)));
+            }
+            else if (kind < 0.6f)
+            {
+                events.push_back(makeMidiEvent(position, noteOff | channel, note, 0));
+            }
+            else if (kind < 0.7f)
+            {
+                // Same key struck and released within a sample
+                events.push_back(makeMidiEvent(position, noteOn | channel, note, 1 + random.nextInt(127)));
+                events.push_back(makeMidiEvent(position, noteOff | channel, note, 0));
+            }
+            else if (kind < 0.8f)
+            {
+                events.push_back(makeMidiEvent(position, noteOn | channel, note, 0));
+            }
+            else if (kind < 0.92f)
+            {
+                const auto wheel = random.nextInt(16384);
+                events.push_back(makeMidiEvent(position, pitchWheel | channel, wheel & 0x7f, wheel >> 7));
+            }
+            else
+            {
+                const auto pedal = random.nextBool() ? sustainPedal : sostenutoPedal;
+                events.push_back(makeMidiEvent(position, controller | channel, pedal, random.nextBool() ? 127 : 0));
+            }
+        }
+
+        std::stable_sort(events.begin(), events.end(), [](const auto& a, const auto& b) { return a.position < b.position; });
+    }
+}
+
+bool MidiStormGenerator::writeLog(const juce::File& logFile, const Settings& settings)
+{
+    logFile.deleteFile();
+    juce::FileOutputStream stream(logFile);
+    if (!stream.openedOk())
+        return false;
+
+    juce::Random random(settings.seed);
+    SessionLog::writeHeader(stream);
+
+    SessionLog::Event prepare;
+    prepare.type = SessionLog::EventType::Prepare;
+    prepare.position = settings.maxBlockSize;
+    prepare.value = static_cast<float>(settings.sampleRate);
+    SessionLog::writeEvent(stream, prepare);
+
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        SessionLog::Event parameter;
+        parameter.type = SessionLog::EventType::Parameter;
+        parameter.position = i;
+        parameter.value = getPatchValue(ParameterIds::parameterIds[i]);
+        if (i == SessionLog::getParameterIndex(ParameterIds::MultiTimbralId))
+        {
+            parameter.value = settings.numChannels > 1 ? 1.0f : 0.0f;
+        }
+
+        SessionLog::writeEvent(stream, parameter);
+    }
+
+    // The parameters above only reach the part being edited, each other part gets the same patch
+    for (auto part = 1; part < std::min(settings.numChannels, SessionLog::numParts); ++part)
+    {
+        for (auto i = 0; i < SessionLog::numParameters; ++i)
+        {
+            if (!SessionLog::isPartParameter(ParameterIds::parameterIds[i]))
+                continue;
+
+            SessionLog::Event parameter;
+            parameter.type = SessionLog::EventType::PartParameter;
+            parameter.data[0] = static_cast<uint8_t>(part);
+            parameter.position = i;
+            parameter.value = getPatchValue(ParameterIds::parameterIds[i]);
+            SessionLog::writeEvent(stream, parameter);
+        }
+    }
+
+    std::vector<SessionLog::Event> midiEvents;
+    for (auto block = 0; block < settings.numBlocks; ++block)
+    {
+        if (random.nextFloat() < settings.playModeChangeProbability)
+        {
+            SessionLog::Event playMode;
+            playMode.type = SessionLog::EventType::PlayMode;
+            playMode.position = random.nextInt(static_cast<int>(EngineUtils::PlayMode::Polyphonic) + 1);
+            SessionLog::writeEvent(stream, playMode);
+        }
+
+        const auto blockSize = settings.randomiseBlockSizes ? 1 + random.nextInt(settings.maxBlockSize) : settings.maxBlockSize;
+        const auto maxEvents = random.nextFloat() < stormBlockProbability ? settings.maxEventsPerBlock : quietBlockMaxEvents;
+
+        SessionLog::Event header;
+        header.type = SessionLog::EventType::Block;
+        header.position = blockSize;
+        SessionLog::writeEvent(stream, header);
+
+        midiEvents.clear();
+        addStormEvents(random, blockSize, random.nextInt(maxEvents + 1), std::clamp(settings.numChannels, 1, SessionLog::numParts), midiEvents);
+        for (const auto& event : midiEvents)
+        {
+            SessionLog::writeEvent(stream, event);
+        }
+    }
+
+    stream.flush();
+    return true;
+}
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    MidiStormGenerator.h
+    Created: 18 Oct 2026 3:20:09pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Writes a synthetic session log full of adversarial MIDI (note floods, rapid
+// re-strikes of the same key, velocity-0 note-ons, pitch-wheel floods, pedal
+// flurries and play-mode changes) for the SessionReplayer to stress the engine with.
+namespace MidiStormGenerator
+{
+    struct Settings
+    {
+        juce::int64 seed = 1;
+        double sampleRate = 44100.0;
+        int maxBlockSize = 512;
+        bool randomiseBlockSizes = true;
+        int numBlocks = 2000;
+        int maxEventsPerBlock = 2000;
+        float playModeChangeProbability = 0.01f; // Per block
+        int numChannels = 1; // Above 1 the storm is spread over the channels in multi-timbral mode
+    };
+
+    bool writeLog(const juce::File& logFile, const Settings& settings);
+}
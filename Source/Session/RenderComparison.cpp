@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    RenderComparison.cpp
+    Created: 18 Oct 2026 1:47:22pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "RenderComparison.h"
+#include <JuceHeader.h>
+
+namespace
+{
+    constexpr int fftOrder = 11;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hopSize = fftSize / 2;
+    constexpr float spectralFloorDb = -120.0f;
+
+    // RMS difference of the dB magnitude spectra over 50% overlapping Hann frames
+    float getSpectralDistanceDb(const float* rendered, const float* reference, int numSamples)
+    {
+        juce::dsp::FFT fft(fftOrder);
+        juce::dsp::WindowingFunction<float> window(fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+        std::vector<float> renderedFrame(2 * fftSize);
+        std::vector<float> referenceFrame(2 * fftSize);
+
+        double sumOfSquares = 0.0;
+        int numBins = 0;
+        for (auto start = 0; start < numSamples; start += hopSize)
+        {
+            const auto frameLength = std::min(fftSize, numSamples - start);
+            std::fill(renderedFrame.begin(), renderedFrame.end(), 0.0f);
+            std::fill(referenceFrame.begin(), referenceFrame.end(), 0.0f);
+            std::copy(rendered + start, rendered + start + frameLength, renderedFrame.begin());
+            std::copy(reference + start, reference + start + frameLength, referenceFrame.begin());
+
+            window.multiplyWithWindowingTable(renderedFrame.data(), fftSize);
+            window.multiplyWithWindowingTable(referenceFrame.data(), fftSize);
+            fft.performFrequencyOnlyForwardTransform(renderedFrame.data());
+            fft.performFrequencyOnlyForwardTransform(referenceFrame.data());
+
+            for (auto bin = 0; bin <= fftSize / 2; ++bin)
+            {
+                const auto renderedDb = juce::Decibels::gainToDecibels(renderedFrame[static_cast<size_t>(bin)], spectralFloorDb);
+                const auto referenceDb = juce::Decibels::gainToDecibels(referenceFrame[static_cast<size_t>(bin)], spectralFloorDb);
+                const auto difference = static_cast<double>(renderedDb - referenceDb);
+                sumOfSquares += difference * difference;
+                ++numBins;
+            }
+        }
+
+        return numBins > 0 ? static_cast<float>(std::sqrt(sumOfSquares / numBins)) : 0.0f;
+    }
+}
+
+RenderComparison::Result RenderComparison::compare(const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& reference, const Tolerance& tolerance)
+{
+    Result result;
+    result.lengthsMatch = rendered.getNumChannels() == reference.getNumChannels()
+                       && rendered.getNumSamples() == reference.getNumSamples();
+
+    const auto numChannels = std::min(rendered.getNumChannels(), reference.getNumChannels());
+    const auto numSamples = std::min(rendered.getNumSamples(), reference.getNumSamples());
+
+    for (auto channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* renderedData = rendered.getReadPointer(channel);
+        const auto* referenceData = reference.getReadPointer(channel);
+
+        for (auto sample = 0; sample < numSamples; ++sample)
+        {
+            // NaN compares false against everything, so it has to be caught before the error is measured
+            const auto isFinite = std::isfinite(renderedData[sample]) && std::isfinite(referenceData[sample]);
+            const auto error = isFinite ? std::abs(renderedData[sample] - referenceData[sample]) : 0.0f;
+            if (!isFinite)
+            {
+                ++result.numNonFiniteSamples;
+            }
+
+            if ((!isFinite || error > 0.0f) && (result.firstMismatchSample < 0 || sample < result.firstMismatchSample))
+            {
+                result.firstMismatchSample = sample;
+            }
+
+            result.maxAbsError = std::max(result.maxAbsError, error);
+        }
+
+        if (tolerance.mode == Mode::SpectralDistance && result.numNonFiniteSamples == 0)
+        {
+            result.spectralDistanceDb = std::max(result.spectralDistanceDb,
+                                                 getSpectralDistanceDb(renderedData, referenceData, numSamples));
+        }
+    }
+
+    if (result.numNonFiniteSamples > 0)
+        return result;
+
+    switch (tolerance.mode)
+    {
+        case Mode::BitExact:
+            result.passed = result.lengthsMatch && result.firstMismatchSample < 0;
+            break;
+        case Mode::MaxAbsError:
+            result.passed = result.lengthsMatch && result.maxAbsError <= tolerance.maxAbsError;
+            break;
+        case Mode::SpectralDistance:
+            result.passed = result.lengthsMatch && result.spectralDistanceDb <= tolerance.maxSpectralDistanceDb;
+            break;
+        default:
+            result.passed = false;
+            break;
+    }
+
+    return result;
+}
+
+bool RenderComparison::writeRender(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate)
+{
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+        return false;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(),
+                                                                              sampleRate,
+                                                                              static_cast<unsigned int>(buffer.getNumChannels()),
+                                                                              32,
+                                                                              {},
+                                                                              0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release(); // The writer owns the stream now
+    return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
+
+bool RenderComparison::readRender(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+{
+    auto stream = file.createInputStream();
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatReader> reader(wavFormat.createReaderFor(stream.release(), true));
+    if (reader == nullptr)
+        return false;
+
+    sampleRate = reader->sampleRate;
+    buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+    return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    RenderComparison.h
+    Created: 18 Oct 2026 1:47:22pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+
+// Compares a render against a stored reference so DSP rewrites can be checked
+// for audible changes instead of by ear.
+namespace RenderComparison
+{
+    enum class Mode : uint8_t
+    {
+        BitExact,
+        MaxAbsError,
+        SpectralDistance
+    };
+
+    struct Tolerance
+    {
+        Mode mode = Mode::BitExact;
+        float maxAbsError = 0.0f;           // Linear, used by MaxAbsError
+        float maxSpectralDistanceDb = 0.5f; // RMS log-spectral distance, used by SpectralDistance
+    };
+
+    struct Result
+    {
+        bool passed = false;
+        bool lengthsMatch = false;
+        int firstMismatchSample = -1;
+        int numNonFiniteSamples = 0; // NaN or Inf in either signal, always a failure
+        float maxAbsError = 0.0f;
+        float spectralDistanceDb = 0.0f;
+    };
+
+    Result compare(const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& reference, const Tolerance& tolerance);
+
+    // References are stored as 32-bit float WAV so they round-trip bit-exactly
+    bool writeRender(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate);
+    bool readRender(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate);
+}
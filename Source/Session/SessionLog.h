@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    SessionLog.h
+    Created: 18 Oct 2026 9:12:40am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include "../Constants/ParameterIds.h"
+
+// Binary layout shared by the SessionRecorder and SessionReplayer.
+// A log is a header (magic + version) followed by fixed-size little-endian events.
+// Version 1 logs have no PartParameter events, their part parameters edit the part the
+// plugin showed at the time, which the replayer works out the same way.
+namespace SessionLog
+{
+    inline constexpr int magic = 0x47534c53; // "SLSG"
+    inline constexpr int version = 2;
+    inline constexpr int numParameters = static_cast<int>(std::size(ParameterIds::parameterIds));
+    inline constexpr int numParts = 16; // Multi-timbral parts, checked against the engine by the replayer
+
+    enum class EventType : uint8_t
+    {
+        Prepare,       // position = samples per block, value = sample rate
+        Block,         // position = number of samples in the block
+        Midi,          // position = sample offset in the current block, data = raw midi bytes
+        Parameter,     // position = index into ParameterIds::parameterIds, value = new value
+        PlayMode,      // position = EngineUtils::PlayMode passed to requestPlayModeChange
+        PartParameter  // data[0] = part, otherwise as Parameter
+    };
+
+    struct Event
+    {
+        EventType type = EventType::Block;
+        uint8_t numBytes = 0;
+        uint8_t data[3] = { 0, 0, 0 };
+        int32_t position = 0;
+        float value = 0.0f;
+    };
+
+    inline int getParameterIndex(const juce::String& parameterID)
+    {
+        for (auto i = 0; i < numParameters; ++i)
+        {
+            if (parameterID == ParameterIds::parameterIds[i])
+                return i;
+        }
+
+        return -1;
+    }
+
+    inline bool isPartParameter(const juce::String& parameterID)
+    {
+        return std::none_of(std::begin(ParameterIds::globalParameterIds), std::end(ParameterIds::globalParameterIds),
+                            [&parameterID](const char* globalId) { return parameterID == globalId; });
+    }
+
+    inline void writeHeader(juce::OutputStream& stream)
+    {
+        stream.writeInt(magic);
+        stream.writeInt(version);
+    }
+
+    inline bool readHeader(juce::InputStream& stream)
+    {
+        if (stream.readInt() != magic)
+            return false;
+
+        const auto logVersion = stream.readInt();
+        return logVersion >= 1 && logVersion <= version;
+    }
+
+    inline void writeEvent(juce::OutputStream& stream, const Event& event)
+    {
+        stream.writeByte(static_cast<char>(event.type));
+        stream.writeByte(static_cast<char>(event.numBytes));
+        stream.write(event.data, sizeof(event.data));
+        stream.writeInt(event.position);
+        stream.writeFloat(event.value);
+    }
+
+    inline bool readEvent(juce::InputStream& stream, Event& event)
+    {
+        if (stream.isExhausted())
+            return false;
+
+        event.type = static_cast<EventType>(stream.readByte());
+        event.numBytes = static_cast<uint8_t>(stream.readByte());
+        if (stream.read(event.data, sizeof(event.data)) != static_cast<int>(sizeof(event.data)))
+            return false;
+
+        event.position = stream.readInt();
+        event.value = stream.readFloat();
+        return event.numBytes <= sizeof(event.data);
+    }
+}
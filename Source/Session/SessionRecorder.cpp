@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    SessionRecorder.cpp
+    Created: 18 Oct 2026 9:31:05am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "SessionRecorder.h"
+#include <JuceHeader.h>
+#include <thread>
+
+SessionRecorder::SessionRecorder()
+    : juce::Thread("Session Recorder")
+    , _events(_fifoSize)
+{
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        _parameterValues[i].store(0.0f);
+        _parameterDirty[i].store(false);
+        for (auto part = 0; part < SessionLog::numParts; ++part)
+        {
+            _partParameterValues[part][i].store(0.0f);
+            _partParameterDirty[part][i].store(false);
+        }
+    }
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    stop();
+}
+
+bool SessionRecorder::start(const juce::File& logFile)
+{
+    stop();
+
+    logFile.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(logFile);
+    if (!stream->openedOk())
+        return false;
+
+    SessionLog::writeHeader(*stream);
+    _stream = std::move(stream);
+
+    // The audio thread stopped pushing in stop(), so both ends of the FIFO are ours until recording restarts
+    _fifo.reset();
+    _droppedEvents.store(0);
+
+    // Make sure the replay starts from the same patch and block setup
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        const auto isPartParameter = SessionLog::isPartParameter(ParameterIds::parameterIds[i]);
+        _parameterDirty[i].store(!isPartParameter, std::memory_order_release);
+        for (auto part = 0; part < SessionLog::numParts; ++part)
+        {
+            _partParameterDirty[part][i].store(isPartParameter, std::memory_order_release);
+        }
+    }
+
+    _preparePending.store(_samplesPerBlock.load() > 0, std::memory_order_release);
+    _recording.store(true, std::memory_order_release);
+    startThread(juce::Thread::Priority::background);
+    return true;
+}
+
+void SessionRecorder::stop()
+{
+    if (!_recording.exchange(false))
+        return;
+
+    waitForAudioThread();
+    stopThread(1000);
+    if (_stream != nullptr)
+    {
+        drain();
+        _stream->flush();
+        _stream.reset();
+    }
+}
+
+bool SessionRecorder::isRecording() const
+{
+    return _recording.load(std::memory_order_acquire);
+}
+
+int SessionRecorder::getNumDroppedEvents() const
+{
+    return _droppedEvents.load(std::memory_order_relaxed);
+}
+
+void SessionRecorder::recordPrepare(double sampleRate, int samplesPerBlock)
+{
+    _sampleRate.store(static_cast<float>(sampleRate), std::memory_order_relaxed);
+    _samplesPerBlock.store(samplesPerBlock, std::memory_order_relaxed);
+    _preparePending.store(true, std::memory_order_release);
+}
+
+void SessionRecorder::recordParameterChange(const juce::String& parameterID, float newValue)
+{
+    const auto index = SessionLog::getParameterIndex(parameterID);
+    if (index < 0)
+        return;
+
+    _parameterValues[index].store(newValue, std::memory_order_relaxed);
+    _parameterDirty[index].store(true, std::memory_order_release);
+}
+
+void SessionRecorder::recordPartParameterChange(int part, const juce::String& parameterID, float newValue)
+{
+    const auto index = SessionLog::getParameterIndex(parameterID);
+    if (index < 0 || !juce::isPositiveAndBelow(part, SessionLog::numParts))
+        return;
+
+    _partParameterValues[part][index].store(newValue, std::memory_order_relaxed);
+    _partParameterDirty[part][index].store(true, std::memory_order_release);
+}
+
+void SessionRecorder::recordBlock(int numSamples, const juce::MidiBuffer& midiMessages)
+{
+    // Flag the block before checking the recording flag, so stop() either sees it or this block sees the stop
+    _isWritingBlock.store(true);
+    if (!_recording.load())
+    {
+        _isWritingBlock.store(false, std::memory_order_release);
+        return;
+    }
+
+    pushPendingChanges();
+
+    SessionLog::Event block;
+    block.type = SessionLog::EventType::Block;
+    block.position = numSamples;
+    push(block);
+
+    for (const auto metadata : midiMessages)
+    {
+        // Sysex and other long messages aren't needed to reproduce the engine load
+        if (metadata.numBytes > 3)
+            continue;
+
+        SessionLog::Event midi;
+        midi.type = SessionLog::EventType::Midi;
+        midi.numBytes = static_cast<uint8_t>(metadata.numBytes);
+        std::memcpy(midi.data, metadata.data, static_cast<size_t>(metadata.numBytes));
+        midi.position = metadata.samplePosition;
+        push(midi);
+    }
+
+    _isWritingBlock.store(false, std::memory_order_release);
+}
+
+void SessionRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        drain();
+        wait(_writeIntervalMs);
+    }
+}
+
+// Returns once a block the audio thread started before the stop has finished pushing. That is
+// at most one recordBlock call, after it the audio thread no longer touches the FIFO
+void SessionRecorder::waitForAudioThread() const
+{
+    while (_isWritingBlock.load())
+    {
+        std::this_thread::yield();
+    }
+}
+
+void SessionRecorder::push(const SessionLog::Event& event)
+{
+    if (_fifo.getFreeSpace() < 1)
+    {
+        _droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    _fifo.write(1).forEach([this, &event](int index) { _events[static_cast<size_t>(index)] = event; });
+}
+
+void SessionRecorder::pushPendingChanges()
+{
+    if (_preparePending.exchange(false, std::memory_order_acquire))
+    {
+        SessionLog::Event prepare;
+        prepare.type = SessionLog::EventType::Prepare;
+        prepare.position = _samplesPerBlock.load(std::memory_order_relaxed);
+        prepare.value = _sampleRate.load(std::memory_order_relaxed);
+        push(prepare);
+    }
+
+    for (auto i = 0; i < SessionLog::numParameters; ++i)
+    {
+        if (_parameterDirty[i].exchange(false, std::memory_order_acquire))
+        {
+            SessionLog::Event parameter;
+            parameter.type = SessionLog::EventType::Parameter;
+            parameter.position = i;
+            parameter.value = _parameterValues[i].load(std::memory_order_relaxed);
+            push(parameter);
+        }
+    }
+
+    for (auto part = 0; part < SessionLog::numParts; ++part)
+    {
+        for (auto i = 0; i < SessionLog::numParameters; ++i)
+        {
+            // Most slots are clean, a plain load skips them without a read-modify-write
+            auto& dirty = _partParameterDirty[part][i];
+            if (dirty.load(std::memory_order_relaxed) && dirty.exchange(false, std::memory_order_acquire))
+            {
+                SessionLog::Event parameter;
+                parameter.type = SessionLog::EventType::PartParameter;
+                parameter.data[0] = static_cast<uint8_t>(part);
+                parameter.position = i;
+                parameter.value = _partParameterValues[part][i].load(std::memory_order_relaxed);
+                push(parameter);
+            }
+        }
+    }
+}
+
+void SessionRecorder::drain()
+{
+    const auto numReady = _fifo.getNumReady();
+    if (numReady == 0 || _stream == nullptr)
+        return;
+
+    _fifo.read(numReady).forEach([this](int index) { SessionLog::writeEvent(*_stream, _events[static_cast<size_t>(index)]); });
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    SessionRecorder.h
+    Created: 18 Oct 2026 9:31:05am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SessionLog.h"
+
+// Captures the MIDI, parameter and block-size stream the engine sees so a live
+// session can be replayed later. The audio thread only pushes into a lock-free
+// FIFO; a background thread drains it to disk.
+class SessionRecorder : private juce::Thread
+{
+public:
+    SessionRecorder();
+    ~SessionRecorder() override;
+
+    bool start(const juce::File& logFile);
+    void stop();
+    bool isRecording() const;
+    int getNumDroppedEvents() const;
+
+    // Safe to call from any thread
+    void recordPrepare(double sampleRate, int samplesPerBlock);
+    void recordParameterChange(const juce::String& parameterID, float newValue);
+    void recordPartParameterChange(int part, const juce::String& parameterID, float newValue);
+
+    // Audio thread only
+    void recordBlock(int numSamples, const juce::MidiBuffer& midiMessages);
+
+private:
+    static constexpr int _fifoSize = 1 << 14;
+    static constexpr int _writeIntervalMs = 20;
+
+    juce::AbstractFifo _fifo { _fifoSize };
+    std::vector<SessionLog::Event> _events;
+    std::unique_ptr<juce::FileOutputStream> _stream;
+    std::atomic<bool> _recording = false;
+    std::atomic<bool> _isWritingBlock = false; // Audio thread, set while recordBlock may push
+    std::atomic<int> _droppedEvents = 0;
+
+    // Parameter changes can arrive on any thread, so they are parked here and
+    // pushed by the audio thread at the start of the next block.
+    std::atomic<float> _parameterValues[SessionLog::numParameters];
+    std::atomic<bool> _parameterDirty[SessionLog::numParameters];
+    std::atomic<float> _partParameterValues[SessionLog::numParts][SessionLog::numParameters];
+    std::atomic<bool> _partParameterDirty[SessionLog::numParts][SessionLog::numParameters];
+
+    std::atomic<bool> _preparePending = false;
+    std::atomic<float> _sampleRate = 44100.0f;
+    std::atomic<int> _samplesPerBlock = 0;
+
+    void run() override;
+    void waitForAudioThread() const;
+    void push(const SessionLog::Event& event);
+    void pushPendingChanges();
+    void drain();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SessionRecorder)
+};
@@ -0,0 +1,474 @@
+/*
+  ==============================================================================
+
+    SessionReplayer.cpp
+    Created: 18 Oct 2026 10:04:51am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "SessionReplayer.h"
+#include <JuceHeader.h>
+
+namespace
+{
+    constexpr int replayChannels = 2;
+
+    float getValue(const float* parameterValues, const char* parameterID)
+    {
+        return parameterValues[SessionLog::getParameterIndex(parameterID)];
+    }
+
+    juce::ADSR::Parameters getEnvelope(const float* parameterValues, const char* attackId, const char* decayId, const char* sustainId, const char* releaseId)
+    {
+        return juce::ADSR::Parameters{
+            getValue(parameterValues, attackId),
+            getValue(parameterValues, decayId),
+            getValue(parameterValues, sustainId),
+            getValue(parameterValues, releaseId)
+        };
+    }
+}
+
+bool SessionReplayer::loadFromFile(const juce::File& logFile)
+{
+    _events.clear();
+
+    juce::FileInputStream stream(logFile);
+    if (!stream.openedOk() || !SessionLog::readHeader(stream))
+        return false;
+
+    SessionLog::Event event;
+    while (SessionLog::readEvent(stream, event))
+    {
+        _events.push_back(event);
+    }
+
+    return !_events.empty();
+}
+
+int SessionReplayer::getNumEvents() const
+{
+    return static_cast<int>(_events.size());
+}
+
+int SessionReplayer::getTotalNumSamples() const
+{
+    int total = 0;
+    for (const auto& event : _events)
+    {
+        if (event.type == SessionLog::EventType::Block)
+        {
+            total += event.position;
+        }
+    }
+
+    return total;
+}
+
+SessionReplayer::Report SessionReplayer::replay(juce::AudioBuffer<float>* renderedOutput) const
+{
+    Report report;
+    auto engine = std::make_unique<MultiTimbralEngine>();
+    auto patches = std::make_unique<Patches>();
+
+    // The governor would make the output depend on how fast this machine renders
+    engine->setLoadReductionEnabled(false);
+
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midiBuffer;
+    int pendingSamples = 0;
+    int renderedSamples = 0;
+
+    if (renderedOutput != nullptr)
+    {
+        renderedOutput->setSize(replayChannels, getTotalNumSamples());
+        renderedOutput->clear();
+    }
+
+    auto renderPendingBlock = [&]()
+    {
+        if (pendingSamples <= 0)
+            return;
+
+        // Hosts may send blocks smaller than the prepared size, never larger
+        if (pendingSamples > buffer.getNumSamples())
+        {
+            buffer.setSize(replayChannels, pendingSamples);
+        }
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), replayChannels, pendingSamples);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        engine->processBlock(block, midiBuffer);
+        const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        const auto sampleRate = report.sampleRate > 0.0 ? report.sampleRate : 44100.0;
+        report.blocks.push_back({ pendingSamples, elapsed, pendingSamples / sampleRate });
+        countInvalidSamples(block, report);
+        if (!engine->isNoteBookkeepingConsistent())
+        {
+            ++report.numInconsistentBlocks;
+        }
+
+        if (renderedOutput != nullptr)
+        {
+            for (auto channel = 0; channel < replayChannels; ++channel)
+            {
+                renderedOutput->copyFrom(channel, renderedSamples, block, channel, 0, pendingSamples);
+            }
+        }
+
+        renderedSamples += pendingSamples;
+        midiBuffer.clear();
+        pendingSamples = 0;
+    };
+
+    for (const auto& event : _events)
+    {
+        switch (event.type)
+        {
+            case SessionLog::EventType::Prepare:
+                renderPendingBlock();
+                report.sampleRate = event.value;
+                buffer.setSize(replayChannels, std::max(1, event.position));
+                engine->prepareToPlay(event.value, event.position);
+                applyGains(*engine, *patches);
+                break;
+            case SessionLog::EventType::Block:
+                renderPendingBlock();
+                pendingSamples = event.position;
+                break;
+            case SessionLog::EventType::Midi:
+                midiBuffer.addEvent(event.data, event.numBytes, event.position);
+                break;
+            case SessionLog::EventType::Parameter:
+                renderPendingBlock();
+                applyParameter(*engine, *patches, getPatchPart(*engine, *patches), event.position, event.value);
+                break;
+            case SessionLog::EventType::PartParameter:
+                renderPendingBlock();
+                applyParameter(*engine, *patches, event.data[0], event.position, event.value);
+                break;
+            case SessionLog::EventType::PlayMode:
+                renderPendingBlock();
+                engine->getPart(getPatchPart(*engine, *patches)).requestPlayModeChange(static_cast<EngineUtils::PlayMode>(event.position));
+                break;
+            default:
+                break;
+        }
+    }
+
+    renderPendingBlock();
+    return report;
+}
+
+// Mirrors PluginProcessor::getPatchPart, which part parameters without a part edit
+int SessionReplayer::getPatchPart(const MultiTimbralEngine& engine, const Patches& patches)
+{
+    if (!engine.isMultiTimbral())
+        return 0;
+
+    return std::clamp(static_cast<int>(getValue(patches.global.data(), ParameterIds::EditPartId)) - 1, 0, MultiTimbralEngine::numParts - 1);
+}
+
+void SessionReplayer::applyParameter(MultiTimbralEngine& engine, Patches& patches, int part, int index, float value)
+{
+    if (!juce::isPositiveAndBelow(index, SessionLog::numParameters))
+        return;
+
+    if (!SessionLog::isPartParameter(ParameterIds::parameterIds[index]))
+    {
+        applyGlobalParameter(engine, patches.global, index, value);
+    }
+    else if (juce::isPositiveAndBelow(part, MultiTimbralEngine::numParts))
+    {
+        applyPartParameter(engine, part, patches.parts[static_cast<size_t>(part)], index, value);
+    }
+}
+
+// Mirrors PluginProcessor::parameterChanged so the replay sees the same engine calls.
+// Tuning, the convolution response and samples are files outside the log and aren't loaded
+void SessionReplayer::applyGlobalParameter(MultiTimbralEngine& engine, Patch& values, int index, float value)
+{
+    values[static_cast<size_t>(index)] = value;
+    const juce::String parameterID = ParameterIds::parameterIds[index];
+
+    if (parameterID == ParameterIds::MultiTimbralId)
+    {
+        engine.setMultiTimbral(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::VoiceBudgetId)
+    {
+        engine.setVoiceBudget(static_cast<int>(value));
+    }
+    else if (parameterID == ParameterIds::OversamplingId ||
+             parameterID == ParameterIds::OfflineOversamplingId)
+    {
+        engine.setOversampling(static_cast<EngineUtils::OversamplingFactor>(static_cast<int>(getValue(values.data(), ParameterIds::OversamplingId))),
+                               static_cast<EngineUtils::OversamplingFactor>(static_cast<int>(getValue(values.data(), ParameterIds::OfflineOversamplingId))));
+    }
+    else if (parameterID == ParameterIds::LimiterLookaheadId)
+    {
+        engine.setLimiterLookahead(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::ReverbMixId)
+    {
+        engine.getReverb().setMix(value);
+    }
+    else if (parameterID == ParameterIds::ReverbDecayId)
+    {
+        engine.getReverb().setDecay(value);
+    }
+    else if (parameterID == ParameterIds::ReverbDampingId)
+    {
+        engine.getReverb().setDamping(value);
+    }
+    else if (parameterID == ParameterIds::DelayMixId)
+    {
+        engine.getDelay().setMix(value);
+    }
+    else if (parameterID == ParameterIds::DelaySyncId)
+    {
+        engine.getDelay().setSync(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::DelayDivisionId)
+    {
+        engine.getDelay().setDivision(static_cast<int>(value));
+    }
+    else if (parameterID == ParameterIds::DelayTimeId)
+    {
+        engine.getDelay().setTime(value);
+    }
+    else if (parameterID == ParameterIds::DelayFeedbackId)
+    {
+        engine.getDelay().setFeedback(value);
+    }
+    else if (parameterID == ParameterIds::DelayToneId)
+    {
+        engine.getDelay().setTone(value);
+    }
+    else if (parameterID == ParameterIds::DelayPingPongId)
+    {
+        engine.getDelay().setPingPong(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::ChorusMixId)
+    {
+        engine.getChorus().setMix(value);
+    }
+    else if (parameterID == ParameterIds::ChorusRateId)
+    {
+        engine.getChorus().setRate(value);
+    }
+    else if (parameterID == ParameterIds::ChorusDepthId)
+    {
+        engine.getChorus().setDepth(value);
+    }
+    else if (parameterID == ParameterIds::ChorusTapsId)
+    {
+        engine.getChorus().setNumTaps(static_cast<int>(value));
+    }
+    else if (parameterID == ParameterIds::BusDriveId ||
+             parameterID == ParameterIds::BusDriveShapeId)
+    {
+        engine.setBusDrive(getValue(values.data(), ParameterIds::BusDriveId),
+                           static_cast<EngineUtils::SaturationShape>(static_cast<int>(getValue(values.data(), ParameterIds::BusDriveShapeId))));
+    }
+    else if (parameterID == ParameterIds::ConvolutionEnabledId)
+    {
+        engine.getConvolver().setEnabled(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::ConvolutionMixId)
+    {
+        engine.getConvolver().setMix(value);
+    }
+}
+
+// Mirrors PluginProcessor::applyPartParameter
+void SessionReplayer::applyPartParameter(MultiTimbralEngine& engine, int part, Patch& values, int index, float value)
+{
+    using WaveType = OscillatorUtils::WaveType;
+
+    values[static_cast<size_t>(index)] = value;
+    const juce::String parameterID = ParameterIds::parameterIds[index];
+    auto& synth = engine.getPart(part);
+
+    if (parameterID == ParameterIds::OscillatorATypeId)
+    {
+        synth.setOscillatorAType(static_cast<WaveType>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::OscillatorBTypeId)
+    {
+        synth.setOscillatorBType(static_cast<WaveType>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::OscillatorSubTypeId)
+    {
+        synth.setOscillatorSubType(static_cast<WaveType>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::OscillatorAGainId)
+    {
+        synth.setOscillatorAGain(value);
+    }
+    else if (parameterID == ParameterIds::OscillatorBGainId)
+    {
+        synth.setOscillatorBGain(value);
+    }
+    else if (parameterID == ParameterIds::OscillatorSubGainId)
+    {
+        synth.setOscillatorSubGain(value);
+    }
+    else if (parameterID == ParameterIds::AmplitudeEnvelopeAttackId ||
+             parameterID == ParameterIds::AmplitudeEnvelopeDecayId ||
+             parameterID == ParameterIds::AmplitudeEnvelopeSustainId ||
+             parameterID == ParameterIds::AmplitudeEnvelopeReleaseId)
+    {
+        synth.setAmplitudeEnvelopeParams(getEnvelope(values.data(),
+                                                      ParameterIds::AmplitudeEnvelopeAttackId,
+                                                      ParameterIds::AmplitudeEnvelopeDecayId,
+                                                      ParameterIds::AmplitudeEnvelopeSustainId,
+                                                      ParameterIds::AmplitudeEnvelopeReleaseId));
+    }
+    else if (parameterID == ParameterIds::ModulationEnvelopeAttackId ||
+             parameterID == ParameterIds::ModulationEnvelopeDecayId ||
+             parameterID == ParameterIds::ModulationEnvelopeSustainId ||
+             parameterID == ParameterIds::ModulationEnvelopeReleaseId)
+    {
+        synth.setModulationEnvelopeParams(getEnvelope(values.data(),
+                                                       ParameterIds::ModulationEnvelopeAttackId,
+                                                       ParameterIds::ModulationEnvelopeDecayId,
+                                                       ParameterIds::ModulationEnvelopeSustainId,
+                                                       ParameterIds::ModulationEnvelopeReleaseId));
+    }
+    else if (parameterID == ParameterIds::MasterGainId)
+    {
+        synth.setMasterGain(value);
+    }
+    else if (parameterID == ParameterIds::PlayModeId)
+    {
+        synth.requestPlayModeChange(static_cast<EngineUtils::PlayMode>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::NotePriorityId)
+    {
+        synth.setNotePriority(static_cast<EngineUtils::NotePriority>(static_cast<int>(value)));
+    }
+    else if (parameterID == ParameterIds::LegatoId)
+    {
+        synth.setLegato(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::GlideTimeId ||
+             parameterID == ParameterIds::GlideModeId)
+    {
+        synth.setGlide(getValue(values.data(), ParameterIds::GlideTimeId),
+                        static_cast<EngineUtils::GlideMode>(static_cast<int>(getValue(values.data(), ParameterIds::GlideModeId))));
+    }
+    else if (parameterID == ParameterIds::VoiceDriveId ||
+             parameterID == ParameterIds::VoiceDriveShapeId)
+    {
+        synth.setVoiceDrive(getValue(values.data(), ParameterIds::VoiceDriveId),
+                             static_cast<EngineUtils::SaturationShape>(static_cast<int>(getValue(values.data(), ParameterIds::VoiceDriveShapeId))));
+    }
+    else if (parameterID == ParameterIds::MpeEnabledId)
+    {
+        synth.setMpeEnabled(value >= 0.5f);
+    }
+    else if (parameterID == ParameterIds::MpePitchBendRangeId)
+    {
+        synth.setMpePitchBendRange(value);
+    }
+    else if (parameterID == ParameterIds::PartPolyphonyId)
+    {
+        engine.setPartPolyphony(part, static_cast<int>(value));
+    }
+}
+
+// Mirrors PluginProcessor::prepareToPlay, which re-applies the gains after preparing the engine
+void SessionReplayer::applyGains(MultiTimbralEngine& engine, const Patches& patches)
+{
+    for (auto part = 0; part < MultiTimbralEngine::numParts; ++part)
+    {
+        auto& synth = engine.getPart(part);
+        const auto* values = patches.parts[static_cast<size_t>(part)].data();
+        synth.setMasterGain(std::clamp(getValue(values, ParameterIds::MasterGainId), 0.0f, 1.0f));
+        synth.setOscillatorAGain(std::clamp(getValue(values, ParameterIds::OscillatorAGainId), 0.0f, 1.0f));
+        synth.setOscillatorBGain(std::clamp(getValue(values, ParameterIds::OscillatorBGainId), 0.0f, 1.0f));
+        synth.setOscillatorSubGain(std::clamp(getValue(values, ParameterIds::OscillatorSubGainId), 0.0f, 1.0f));
+    }
+}
+
+void SessionReplayer::countInvalidSamples(const juce::AudioBuffer<float>& block, Report& report)
+{
+    for (auto channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        const auto* channelData = block.getReadPointer(channel);
+        for (auto sample = 0; sample < block.getNumSamples(); ++sample)
+        {
+            const auto value = channelData[sample];
+            if (!std::isfinite(value))
+            {
+                ++report.numNonFiniteSamples;
+            }
+            else if (std::fpclassify(value) == FP_SUBNORMAL)
+            {
+                ++report.numDenormalSamples;
+            }
+        }
+    }
+}
+
+double SessionReplayer::Report::getTotalSeconds() const
+{
+    auto total = 0.0;
+    for (const auto& block : blocks)
+    {
+        total += block.seconds;
+    }
+
+    return total;
+}
+
+double SessionReplayer::Report::getWorstBlockSeconds() const
+{
+    auto worst = 0.0;
+    for (const auto& block : blocks)
+    {
+        worst = std::max(worst, block.seconds);
+    }
+
+    return worst;
+}
+
+double SessionReplayer::Report::getWorstDeadlineRatio() const
+{
+    auto worst = 0.0;
+    for (const auto& block : blocks)
+    {
+        if (block.deadlineSeconds > 0.0)
+        {
+            worst = std::max(worst, block.seconds / block.deadlineSeconds);
+        }
+    }
+
+    return worst;
+}
+
+// Writes one CSV row per block: index, samples, seconds, fraction of the real-time deadline
+bool SessionReplayer::Report::writeToFile(const juce::File& file) const
+{
+    file.deleteFile();
+    juce::FileOutputStream stream(file);
+    if (!stream.openedOk())
+        return false;
+
+    stream << "block,samples,seconds,deadlineRatio\n";
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        const auto& block = blocks[i];
+        const auto ratio = block.deadlineSeconds > 0.0 ? block.seconds / block.deadlineSeconds : 0.0;
+        stream << juce::String(static_cast<int>(i)) << "," << juce::String(block.numSamples) << ","
+               << juce::String(block.seconds, 9) << "," << juce::String(ratio, 6) << "\n";
+    }
+
+    stream.flush();
+    return true;
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    SessionReplayer.h
+    Created: 18 Oct 2026 10:04:51am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SessionLog.h"
+#include "../Engine/MultiTimbralEngine.h"
+
+// Drives a fresh MultiTimbralEngine from a log written by the SessionRecorder and
+// times every block, so a captured live session can be used as a benchmark.
+// Every part plays its own MIDI channel and patch, the way the plugin ran them.
+class SessionReplayer
+{
+public:
+    struct BlockTiming
+    {
+        int numSamples = 0;
+        double seconds = 0.0;
+        double deadlineSeconds = 0.0; // Real-time duration of the block
+    };
+
+    struct Report
+    {
+        double sampleRate = 0.0;
+        std::vector<BlockTiming> blocks;
+        int numNonFiniteSamples = 0;
+        int numDenormalSamples = 0;
+        int numInconsistentBlocks = 0; // Blocks after which the engine's note bookkeeping didn't add up
+
+        double getTotalSeconds() const;
+        double getWorstBlockSeconds() const;
+        double getWorstDeadlineRatio() const;
+        bool writeToFile(const juce::File& file) const;
+    };
+
+    bool loadFromFile(const juce::File& logFile);
+    int getNumEvents() const;
+    int getTotalNumSamples() const;
+
+    // Pass a buffer to also collect the rendered audio, e.g. to compare it
+    // against a stored reference with RenderComparison
+    Report replay(juce::AudioBuffer<float>* renderedOutput = nullptr) const;
+
+private:
+    static_assert(SessionLog::numParts == MultiTimbralEngine::numParts, "Logs need a slot for every part");
+
+    using Patch = std::array<float, SessionLog::numParameters>;
+
+    // The global parameters, and the part parameters of every part
+    struct Patches
+    {
+        Patch global {};
+        std::array<Patch, MultiTimbralEngine::numParts> parts {};
+    };
+
+    std::vector<SessionLog::Event> _events;
+
+    static int getPatchPart(const MultiTimbralEngine& engine, const Patches& patches);
+    static void applyParameter(MultiTimbralEngine& engine, Patches& patches, int part, int index, float value);
+    static void applyGlobalParameter(MultiTimbralEngine& engine, Patch& values, int index, float value);
+    static void applyPartParameter(MultiTimbralEngine& engine, int part, Patch& values, int index, float value);
+    static void applyGains(MultiTimbralEngine& engine, const Patches& patches);
+    static void countInvalidSamples(const juce::AudioBuffer<float>& block, Report& report);
+};
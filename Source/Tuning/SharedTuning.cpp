@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    SharedTuning.cpp
+    Created: 20 Oct 2026 10:12:37am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "SharedTuning.h"
+
+SharedTuning::SharedTuning()
+    : _activeTuning(std::make_unique<TuningTable>(_tuning))
+{
+}
+
+SharedTuning::~SharedTuning() = default;
+
+void SharedTuning::setTuning(const TuningTable& tuning)
+{
+    _tuning = tuning;
+    publish();
+}
+
+void SharedTuning::setPitchBendRange(float semitones)
+{
+    _tuning.setPitchBendRange(semitones);
+    publish();
+}
+
+const TuningTable& SharedTuning::getTuning() const
+{
+    return _tuning;
+}
+
+const TuningTable& SharedTuning::update()
+{
+    if (auto* tuning = _tunings.takePending())
+    {
+        _tunings.retire(_activeTuning.release());
+        _activeTuning.reset(tuning);
+    }
+
+    return *_activeTuning;
+}
+
+const TuningTable& SharedTuning::getActiveTuning() const
+{
+    return *_activeTuning;
+}
+
+void SharedTuning::publish()
+{
+    // Free the table the audio thread has finished with, then replace any it hasn't picked up yet
+    _tunings.freeRetired();
+    _tunings.publish(std::make_unique<TuningTable>(_tuning));
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    SharedTuning.h
+    Created: 20 Oct 2026 10:12:37am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TuningTable.h"
+#include "../Utils/AudioThreadHandover.h"
+
+// The tuning one or more engines play from. The message thread edits a copy and publishes
+// it, the audio thread swaps it in with update() and parks the old table for the message
+// thread to delete, so nothing is allocated or freed on the audio thread.
+class SharedTuning
+{
+public:
+    SharedTuning();
+    ~SharedTuning();
+
+    // Message thread only
+    void setTuning(const TuningTable& tuning);
+    void setPitchBendRange(float semitones);
+    const TuningTable& getTuning() const;
+
+    // Audio thread. Engines sharing the tuning all call this in the same callback, the first one takes the swap
+    const TuningTable& update();
+    const TuningTable& getActiveTuning() const;
+
+private:
+    TuningTable _tuning; // Message thread copy
+    std::unique_ptr<TuningTable> _activeTuning;
+    AudioThreadHandover<TuningTable> _tunings;
+
+    // Helpers
+    void publish();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedTuning)
+};
@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+    TuningTable.cpp
+    Created: 19 Oct 2026 1:14:52pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "TuningTable.h"
+#include <JuceHeader.h>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+namespace
+{
+    constexpr double concertPitch = 440.0;
+    constexpr int concertPitchNote = 69;
+    constexpr int middleC = 60;
+    constexpr double middleCFrequency = 261.625565300598; // 12-TET, A4 = 440Hz
+
+    struct KeyboardMapping
+    {
+        int firstNote = 0;
+        int lastNote = TuningTable::numMidiNotes - 1;
+        int middleNote = middleC;
+        int referenceNote = middleC;
+        double referenceFrequency = middleCFrequency;
+        int octaveDegree = 0;                   // 0 uses the scale's own period
+        std::vector<std::optional<int>> degrees; // Empty maps keys linearly onto scale degrees
+    };
+
+    int floorDivide(int value, int divisor)
+    {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    // Scala lines starting with '!' are comments
+    juce::StringArray getContentLines(const juce::String& text, bool keepEmptyLines)
+    {
+        juce::StringArray lines;
+        for (const auto& line : juce::StringArray::fromLines(text))
+        {
+            const auto trimmed = line.trim();
+            if (trimmed.startsWithChar('!') || (!keepEmptyLines && trimmed.isEmpty()))
+                continue;
+
+            lines.add(trimmed);
+        }
+
+        return lines;
+    }
+
+    // Cents if the value has a '.', otherwise a ratio ("3/2" or "2")
+    std::optional<double> parsePitch(const juce::String& line)
+    {
+        const auto token = line.upToFirstOccurrenceOf(" ", false, false).upToFirstOccurrenceOf("\t", false, false);
+        if (token.isEmpty() || !token.containsOnly("0123456789.-+/"))
+            return std::nullopt;
+
+        if (token.containsChar('.'))
+            return std::pow(2.0, token.getDoubleValue() / 1200.0);
+
+        const auto numerator = token.upToFirstOccurrenceOf("/", false, false).getDoubleValue();
+        const auto denominator = token.containsChar('/') ? token.fromFirstOccurrenceOf("/", false, false).getDoubleValue() : 1.0;
+        if (numerator <= 0.0 || denominator <= 0.0)
+            return std::nullopt;
+
+        return numerator / denominator;
+    }
+
+    // Ratios of scale degrees 1..n, the last one being the period (usually 2/1)
+    bool parseScale(const juce::String& text, std::vector<double>& ratios)
+    {
+        const auto lines = getContentLines(text, true);
+
+        // Line 0 is the description, which may be blank
+        if (lines.size() < 2)
+            return false;
+
+        const auto numNotes = lines[1].getIntValue();
+        if (numNotes < 1)
+            return false;
+
+        ratios.clear();
+        for (auto i = 2; i < lines.size() && static_cast<int>(ratios.size()) < numNotes; ++i)
+        {
+            if (lines[i].isEmpty())
+                continue;
+
+            const auto ratio = parsePitch(lines[i]);
+            if (!ratio.has_value() || *ratio <= 0.0)
+                return false;
+
+            ratios.push_back(*ratio);
+        }
+
+        return static_cast<int>(ratios.size()) == numNotes;
+    }
+
+    bool parseKeyboardMapping(const juce::String& text, KeyboardMapping& mapping)
+    {
+        const auto lines = getContentLines(text, false);
+        constexpr int numHeaderLines = 7;
+        if (lines.size() < numHeaderLines)
+            return false;
+
+        const auto mapSize = lines[0].getIntValue();
+        mapping.firstNote = lines[1].getIntValue();
+        mapping.lastNote = lines[2].getIntValue();
+        mapping.middleNote = lines[3].getIntValue();
+        mapping.referenceNote = lines[4].getIntValue();
+        mapping.referenceFrequency = lines[5].getDoubleValue();
+        mapping.octaveDegree = lines[6].getIntValue();
+
+        if (mapSize < 0 || mapping.referenceFrequency <= 0.0 || mapping.octaveDegree < 0)
+            return false;
+
+        // Entries missing from the end of the list leave those keys unmapped
+        mapping.degrees.assign(static_cast<size_t>(mapSize), std::nullopt);
+        for (auto i = 0; i < mapSize && numHeaderLines + i < lines.size(); ++i)
+        {
+            const auto& entry = lines[numHeaderLines + i];
+            if (!entry.startsWithChar('x') && !entry.startsWithChar('X'))
+            {
+                mapping.degrees[static_cast<size_t>(i)] = entry.getIntValue();
+            }
+        }
+
+        return true;
+    }
+
+    // Ratio of any scale degree to degree 0, repeating the scale every period
+    double getDegreeRatio(const std::vector<double>& ratios, int degree)
+    {
+        const auto numNotes = static_cast<int>(ratios.size());
+        const auto periods = floorDivide(degree, numNotes);
+        const auto index = degree - periods * numNotes;
+        const auto ratio = index == 0 ? 1.0 : ratios[static_cast<size_t>(index - 1)];
+        return ratio * std::pow(ratios.back(), periods);
+    }
+
+    // Ratio of a key to the mapping's middle note
+    std::optional<double> getKeyRatio(const std::vector<double>& ratios, const KeyboardMapping& mapping, int midiNote)
+    {
+        if (midiNote < mapping.firstNote || midiNote > mapping.lastNote)
+            return std::nullopt;
+
+        const auto offset = midiNote - mapping.middleNote;
+        if (mapping.degrees.empty())
+            return getDegreeRatio(ratios, offset);
+
+        const auto mapSize = static_cast<int>(mapping.degrees.size());
+        const auto repeats = floorDivide(offset, mapSize);
+        const auto& degree = mapping.degrees[static_cast<size_t>(offset - repeats * mapSize)];
+        if (!degree.has_value())
+            return std::nullopt;
+
+        const auto formalOctave = mapping.octaveDegree > 0 ? getDegreeRatio(ratios, mapping.octaveDegree) : ratios.back();
+        return getDegreeRatio(ratios, *degree) * std::pow(formalOctave, repeats);
+    }
+}
+
+TuningTable::TuningTable()
+{
+    resetToEqualTemperament();
+    buildPitchBendFactors();
+}
+
+bool TuningTable::loadScala(const juce::String& scaleText, const juce::String& keyboardMappingText)
+{
+    std::vector<double> ratios;
+    if (!parseScale(scaleText, ratios))
+        return false;
+
+    KeyboardMapping mapping;
+    if (keyboardMappingText.trim().isNotEmpty() && !parseKeyboardMapping(keyboardMappingText, mapping))
+        return false;
+
+    // The reference key has to sound for the rest of the keyboard to be pinned to it
+    const auto referenceRatio = getKeyRatio(ratios, mapping, mapping.referenceNote);
+    if (!referenceRatio.has_value())
+        return false;
+
+    for (auto note = 0; note < numMidiNotes; ++note)
+    {
+        const auto ratio = getKeyRatio(ratios, mapping, note);
+        _noteFrequencies[static_cast<size_t>(note)] = ratio.has_value()
+                                                        ? static_cast<float>(mapping.referenceFrequency * *ratio / *referenceRatio)
+                                                        : 0.0f;
+    }
+
+    return true;
+}
+
+bool TuningTable::loadScalaFiles(const juce::File& scaleFile, const juce::File& keyboardMappingFile)
+{
+    if (!scaleFile.existsAsFile())
+        return false;
+
+    const auto keyboardMappingText = keyboardMappingFile.existsAsFile() ? keyboardMappingFile.loadFileAsString() : juce::String();
+    return loadScala(scaleFile.loadFileAsString(), keyboardMappingText);
+}
+
+void TuningTable::resetToEqualTemperament()
+{
+    for (auto note = 0; note < numMidiNotes; ++note)
+    {
+        _noteFrequencies[static_cast<size_t>(note)] = static_cast<float>(concertPitch * std::pow(2.0, (note - concertPitchNote) / 12.0));
+    }
+}
+
+void TuningTable::setPitchBendRange(float semitones)
+{
+    _pitchBendRange = std::clamp(semitones, 0.0f, _maxPitchBendRange);
+    buildPitchBendFactors();
+}
+
+float TuningTable::getPitchBendRange() const
+{
+    return _pitchBendRange;
+}
+
+float TuningTable::getNoteFrequency(int midiNote) const
+{
+    return _noteFrequencies[static_cast<size_t>(std::clamp(midiNote, 0, numMidiNotes - 1))];
+}
+
+bool TuningTable::isNoteMapped(int midiNote) const
+{
+    return getNoteFrequency(midiNote) > 0.0f;
+}
+
+float TuningTable::getPitchBendFactor(int pitchWheelPosition) const
+{
+    return _pitchBendFactors[static_cast<size_t>(std::clamp(pitchWheelPosition, 0, numPitchWheelPositions - 1))];
+}
+
+void TuningTable::buildPitchBendFactors()
+{
+    // Bends are in 12-TET semitones whatever the scale, as on most synths
+    for (auto position = 0; position < numPitchWheelPositions; ++position)
+    {
+        const auto normalizedOffset = std::clamp((position - pitchWheelCentre) / static_cast<double>(pitchWheelCentre), -1.0, 1.0);
+        _pitchBendFactors[static_cast<size_t>(position)] = static_cast<float>(std::pow(2.0, normalizedOffset * _pitchBendRange / 12.0));
+    }
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    TuningTable.h
+    Created: 19 Oct 2026 1:14:52pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Precomputed note frequencies and pitch-wheel bend factors so voices only do
+// lookups. Built on the message thread and handed to the engine as a whole
+// (see SynthEngine::setTuning). Defaults to 12-TET with A4 = 440Hz.
+class TuningTable
+{
+public:
+    static constexpr int numMidiNotes = 128;
+    static constexpr int numPitchWheelPositions = 16384;
+    static constexpr int pitchWheelCentre = 8192;
+
+    TuningTable();
+    ~TuningTable() = default;
+
+    // Scala scale (.scl) with an optional keyboard mapping (.kbm). On failure the table is left untouched
+    bool loadScala(const juce::String& scaleText, const juce::String& keyboardMappingText);
+    bool loadScalaFiles(const juce::File& scaleFile, const juce::File& keyboardMappingFile);
+    void resetToEqualTemperament();
+
+    void setPitchBendRange(float semitones);
+    float getPitchBendRange() const;
+
+    // Lookups, safe on the audio thread
+    float getNoteFrequency(int midiNote) const;
+    bool isNoteMapped(int midiNote) const;
+    float getPitchBendFactor(int pitchWheelPosition) const;
+
+private:
+    std::array<float, numMidiNotes> _noteFrequencies; // 0 for keys the mapping leaves unmapped
+    std::array<float, numPitchWheelPositions> _pitchBendFactors;
+    float _pitchBendRange = 2.0f;
+
+    static constexpr float _maxPitchBendRange = 48.0f;
+
+    // Helpers
+    void buildPitchBendFactors();
+};
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    AudioThreadHandover.h
+    Created: 28 Oct 2026 8:41:56pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Hands objects built on another thread to the audio thread without it ever allocating or
+// freeing. The audio thread takes the pending object and retires the one it replaces, which
+// another thread frees later. Nothing is taken while a retired object is still waiting to be
+// freed, so an object published before then is picked up a block later. Publishing again
+// before it is taken replaces the waiting object.
+template <typename ObjectType>
+class AudioThreadHandover
+{
+public:
+    AudioThreadHandover() = default;
+
+    ~AudioThreadHandover()
+    {
+        delete _pending.exchange(nullptr);
+        delete _retired.exchange(nullptr);
+    }
+
+    // Any thread but the audio thread
+    void publish(std::unique_ptr<ObjectType> object)
+    {
+        delete _pending.exchange(object.release(), std::memory_order_acq_rel);
+    }
+
+    // Audio thread. The caller owns the returned object, or gets nullptr if there's nothing to take yet.
+    // The object it replaces must go to retire() once nothing on the audio thread uses it any more
+    ObjectType* takePending()
+    {
+        if (_retired.load(std::memory_order_acquire) != nullptr || _pending.load(std::memory_order_relaxed) == nullptr)
+            return nullptr;
+
+        return _pending.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    void retire(ObjectType* object)
+    {
+        _retired.store(object, std::memory_order_release);
+    }
+
+    // The freeing thread, once nothing can still be using a retired object
+    bool hasRetired() const
+    {
+        return _retired.load(std::memory_order_acquire) != nullptr;
+    }
+
+    void freeRetired()
+    {
+        delete _retired.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+private:
+    std::atomic<ObjectType*> _pending = nullptr;
+    std::atomic<ObjectType*> _retired = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (AudioThreadHandover)
+};
@@ -1,22 +1,52 @@
-/*
-  ==============================================================================
-
-    EngineUtils.h
-    Created: 9 Jun 2025 7:53:44pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <cstdint>
-
-namespace EngineUtils
-{
-    enum class PlayMode : uint8_t
-    {
-        Monophonic,
-        Duophonic,
-        Polyphonic
-    };
-}
+/*
+  ==============================================================================
+
+    EngineUtils.h
+    Created: 9 Jun 2025 7:53:44pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <cstdint>
+
+namespace EngineUtils
+{
+    enum class PlayMode : uint8_t
+    {
+        Monophonic,
+        Duophonic,
+        Polyphonic
+    };
+    
+    // Which held key a mono or duo voice follows
+    enum class NotePriority : uint8_t
+    {
+        Last,
+        Low,
+        High
+    };
+    
+    enum class GlideMode : uint8_t
+    {
+        ConstantTime, // Every glide takes the glide time
+        ConstantRate  // Glide time per octave
+    };
+    
+    // Voice render rate, each step doubles it
+    enum class OversamplingFactor : uint8_t
+    {
+        Off,
+        TwoTimes,
+        FourTimes,
+        EightTimes
+    };
+    
+    enum class SaturationShape : uint8_t
+    {
+        Tanh,
+        HardClip,
+        Foldback // Triangle fold, the signal reflects back off +-1
+    };
+}
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    IdleTracker.h
+    Created: 28 Oct 2026 8:14:03pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Lets a bus effect skip its blocks while silence goes in and nothing is left to come out.
+// startBlock takes the input peak and says whether the block needs processing, endBlock
+// counts silent samples and goes idle once the effect's tail length of them has passed.
+class IdleTracker
+{
+public:
+    static constexpr float silenceThreshold = 1.0e-5f; // -100dB, quieter output counts as silent
+
+    static float getPeak(const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+    {
+        auto peak = 0.0f;
+        for (auto channel = 0; channel < std::min(buffer.getNumChannels(), numChannels); ++channel)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(channel), numSamples);
+            peak = std::max({ peak, -range.getStart(), range.getEnd() });
+        }
+
+        return peak;
+    }
+
+    // False while idle and the input is silent, the block can be left as it is
+    bool startBlock(float inputPeak)
+    {
+        _isInputSilent = inputPeak == 0.0f;
+        if (_isIdle && _isInputSilent)
+            return false;
+
+        _isIdle = false;
+        return true;
+    }
+
+    // True on the block the effect goes idle, so it can clear any state it keeps
+    bool endBlock(int numSamples, int64_t tailLength, float outputPeak = 0.0f)
+    {
+        _silentSamples = _isInputSilent && outputPeak < silenceThreshold ? _silentSamples + numSamples : 0;
+        if (_silentSamples < tailLength)
+            return false;
+
+        reset();
+        return true;
+    }
+
+    bool isIdle() const { return _isIdle; }
+
+    void reset()
+    {
+        _isIdle = true;
+        _silentSamples = 0;
+    }
+
+private:
+    bool _isIdle = true;
+    bool _isInputSilent = true;
+    int64_t _silentSamples = 0;
+};
@@ -1,44 +1,110 @@
-/*
-  ==============================================================================
-
-    MidiUtils.cpp
-    Created: 29 May 2025 10:05:59pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#include "MidiUtils.h"
-#include <string_view>
-
-namespace
-{
-    static constexpr std::string_view sharpNames[] =
-    {
-        "C", "C#", "D", "D#", "E", "F",
-        "F#", "G", "G#", "A", "A#", "B"
-    };
-    
-    static constexpr std::string_view flatNames[]  =
-    {
-        "C", "Db", "D", "Eb", "E", "F",
-        "Gb", "G", "Ab", "A", "Bb", "B"
-    };
-}
-
-float MidiUtils::getMidiNoteInHertz(int midiNote)
-{
-    return 440.0f * std::pow(2.0f, (midiNote-69) / 12.0f);
-}
-
-std::string MidiUtils::getNoteNameWithEnharmonics(int midiNote)
-{   
-    int noteInOctave = midiNote % 12;
-    int octave = (midiNote / 12) -1;
-    
-    // If the note name is the same (like C, D, E, F, G, A, B) show one note
-    if (sharpNames[noteInOctave] == flatNames[noteInOctave])
-        return std::string(sharpNames[noteInOctave]) + std::to_string(octave);
-    
-    return std::string(sharpNames[noteInOctave]) + " / " + std::string(flatNames[noteInOctave]) + std::to_string(octave);
-}
+/*
+  ==============================================================================
+
+    MidiUtils.cpp
+    Created: 29 May 2025 10:05:59pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "MidiUtils.h"
+#include "FastMathUtils.h"
+#include <string_view>
+#include <algorithm>
+
+namespace
+{
+    static constexpr std::string_view sharpNames[] =
+    {
+        "C", "C#", "D", "D#", "E", "F",
+        "F#", "G", "G#", "A", "A#", "B"
+    };
+    
+    static constexpr std::string_view flatNames[]  =
+    {
+        "C", "Db", "D", "Eb", "E", "F",
+        "Gb", "G", "Ab", "A", "Bb", "B"
+    };
+}
+
+float MidiUtils::getMidiNoteInHertz(int midiNote)
+{
+    return 440.0f * FastMathUtils::semitonesToRatio(static_cast<float>(midiNote - 69));
+}
+
+std::string MidiUtils::getNoteNameWithEnharmonics(int midiNote)
+{   
+    int noteInOctave = midiNote % 12;
+    int octave = (midiNote / 12) -1;
+    
+    // If the note name is the same (like C, D, E, F, G, A, B) show one note
+    if (sharpNames[noteInOctave] == flatNames[noteInOctave])
+        return std::string(sharpNames[noteInOctave]) + std::to_string(octave);
+    
+    return std::string(sharpNames[noteInOctave]) + " / " + std::string(flatNames[noteInOctave]) + std::to_string(octave);
+}
+
+int MidiUtils::getMidiNoteFromName(std::string_view name)
+{
+    auto isDigit = [](char character) { return character >= '0' && character <= '9'; };
+    auto toLower = [](char character) { return character >= 'A' && character <= 'Z' ? static_cast<char>(character - 'A' + 'a') : character; };
+    auto startsWith = [&toLower](std::string_view text, std::string_view prefix)
+    {
+        return text.size() >= prefix.size()
+            && std::equal(prefix.begin(), prefix.end(), text.begin(), [&toLower](char a, char b) { return toLower(a) == toLower(b); });
+    };
+    auto parseNumber = [&isDigit](std::string_view text, int& value)
+    {
+        auto sign = 1;
+        if (!text.empty() && text.front() == '-')
+        {
+            sign = -1;
+            text.remove_prefix(1);
+        }
+        
+        if (text.empty() || text.size() > 3 || !std::all_of(text.begin(), text.end(), isDigit))
+            return false;
+        
+        value = 0;
+        for (const auto character : text)
+        {
+            value = value * 10 + (character - '0');
+        }
+        
+        value *= sign;
+        return true;
+    };
+    
+    auto note = -1;
+    if (!name.empty() && isDigit(name.front()))
+    {
+        if (!parseNumber(name, note))
+            return -1;
+    }
+    else
+    {
+        // Longest match first so "C#" isn't read as "C", case doesn't matter so "bb2" is "Bb2"
+        auto noteInOctave = -1;
+        size_t nameLength = 0;
+        for (auto i = 0; i < 12; ++i)
+        {
+            for (const auto candidate : { sharpNames[i], flatNames[i] })
+            {
+                if (candidate.size() > nameLength && startsWith(name, candidate))
+                {
+                    noteInOctave = i;
+                    nameLength = candidate.size();
+                }
+            }
+        }
+        
+        auto octave = 0;
+        if (noteInOctave < 0 || !parseNumber(name.substr(nameLength), octave))
+            return -1;
+        
+        note = (octave + 1) * 12 + noteInOctave;
+    }
+    
+    return note >= 0 && note <= 127 ? note : -1;
+}
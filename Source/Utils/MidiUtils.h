@@ -1,18 +1,20 @@
-/*
-  ==============================================================================
-
-    MidiUtils.h
-    Created: 29 May 2025 10:05:01pm
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <string>
-
-namespace MidiUtils
-{
-    float getMidiNoteInHertz(int midiNote);
-    std::string getNoteNameWithEnharmonics(int midiNote);
-}
+/*
+  ==============================================================================
+
+    MidiUtils.h
+    Created: 29 May 2025 10:05:01pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace MidiUtils
+{
+    float getMidiNoteInHertz(int midiNote);
+    std::string getNoteNameWithEnharmonics(int midiNote);
+    int getMidiNoteFromName(std::string_view name); // "C4", "F#2", "Bb-1" in any case or a plain number, -1 if it's neither
+}
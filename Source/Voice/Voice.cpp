@@ -1,335 +1,576 @@
-/*
-  ==============================================================================
-
-    Voice.cpp
-    Created: 17 May 2025 11:00:53am
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "../Utils/MidiUtils.h"
-#include "../Oscillator/Oscillator.h"
-#include "Voice.h"
-
-// Constructors
-Voice::Voice()
-{
-    initialiseDefaults();
-}
-
-// Private methods
-void Voice::initialiseDefaults()
-{
-    // Oscillators
-    initialiseOscillators(OscillatorUtils::WaveType::Sine,
-                          OscillatorUtils::WaveType::Sine,
-                          OscillatorUtils::WaveType::Sine,
-                          OscillatorUtils::OctaveOffset::One);
-    
-    // Envelopes
-    resetEnvelopes();
-    
-    // Gains
-    setOscillatorGains(0.0f, 0.0f, 0.0f);
-}
-
-void Voice::updateOscillatorFrequencies(std::optional<int> midiNote)
-{
-    auto note = midiNote.value_or((_midiNote >= 0 ? _midiNote : _previousMidiNote));
-    if (note < 0)
-    {
-        _currentFrequency = 0.0f;
-    }
-    else
-    {
-        auto pitchBendFactor = std::pow(2.0f, _pitchBendSemitoneOffset / 12.0f);
-        _currentFrequency = std::clamp(MidiUtils::getMidiNoteInHertz(note), 0.0f, 20000.0f) * pitchBendFactor;
-        if (_midiNote >= 0)
-        {
-            _previousMidiNote = _midiNote;
-        }
-    }
-    
-    _oscillatorA.setFrequency(_currentFrequency, _sampleRate);
-    _oscillatorB.setFrequency(_currentFrequency, _sampleRate);
-    
-    auto subFreq = OscillatorUtils::applyOctaveOffset(_currentFrequency, _oscillatorSubOffset);
-    _oscillatorSub.setFrequency(subFreq, _sampleRate);
-}
-
-void Voice:: setEnvelopeSampleRate(double sampleRate)
-{
-    _amplitudeEnvelope.setSampleRate(sampleRate);
-    _modulationEnvelope.setSampleRate(sampleRate);
-}
-
-void Voice::resetEnvelopes()
-{
-    // Assign them to the envelopes
-    _amplitudeEnvelope.setParameters(_amplitudeEnvelopeParams);
-    _modulationEnvelope.setParameters(_modulationEnvelopeParams);
-    
-    // Reset the envelopes
-    _amplitudeEnvelope.reset();
-    _modulationEnvelope.reset();
-}
-
-void Voice::initialiseOscillators(OscillatorUtils::WaveType typeA,
-                                  OscillatorUtils::WaveType typeB,
-                                  OscillatorUtils::WaveType typeSub,
-                                  OscillatorUtils::OctaveOffset oscillatorSubOffset)
-{
-    // Set oscillator types and offset amount
-    setOscillatorTypes(typeA, typeB, typeSub);
-    setOscillatorSubOffset(oscillatorSubOffset);
-    
-    // Set default pulse width for square waves
-    _oscillatorA.setPulseWidth(0.5f);
-    _oscillatorB.setPulseWidth(0.5f);
-    _oscillatorSub.setPulseWidth(0.5f);
-    
-    // Reset phase
-    _oscillatorA.resetPhase();
-    _oscillatorB.resetPhase();
-    _oscillatorSub.resetPhase();
-}
-
-void Voice::activateEnvelopes()
-{
-    _amplitudeEnvelope.noteOn();
-    _modulationEnvelope.noteOn();
-}
-
-void Voice::deactivateEnvelopes()
-{
-    _amplitudeEnvelope.noteOff();
-    _modulationEnvelope.noteOff();
-}
-
-float Voice::getNextSampleSummed()
-{
-    // Generate the samples
-    auto sampleA = getNextSample(_oscillatorA, _gainA);
-    auto sampleB = getNextSample(_oscillatorB, _gainB);
-    auto sampleSub = getNextSample(_oscillatorSub, _gainSub);
-    
-    // Return the sum of each sample
-    return sampleA + sampleB + sampleSub;
-}
-
-float Voice::getNextSample(Oscillator& oscillator, Gain& gain)
-{
-    return gain.processSample(oscillator.processSample());
-}
-
-// Initialisation
-void Voice::prepare(double sampleRate, int samplePerBlock, int numChannels)
-{
-    if (_sampleRate != sampleRate)
-    {
-        _sampleRate = sampleRate;
-        setEnvelopeSampleRate(sampleRate);
-    }
-    
-    int note = (_midiNote >= 0) ? _midiNote : _previousMidiNote;
-    float gainA = (note >= 0) ? std::clamp(_velocity * _gainA.getCurrentGain(), 0.0f, 1.0f) : 0.0f;
-    float gainB = (note >= 0) ? std::clamp(_velocity * _gainB.getCurrentGain(), 0.0f, 1.0f) : 0.0f;
-    float gainSub = (note >= 0) ? std::clamp(_velocity * _gainSub.getCurrentGain(), 0.0f, 1.0f) : 0.0f;
-
-    
-    updateOscillatorFrequencies(note);
-    setOscillatorGains(gainA, gainB, gainSub);
-}
-
-// Playback behaviour
-void Voice::startNote(int midiNote, float velocity)
-{
-    _midiNote = midiNote;
-    _velocity = velocity;
-    _currentFrequency = MidiUtils::getMidiNoteInHertz(_midiNote);
-    
-    updateOscillatorFrequencies(_midiNote);
-    
-    activateEnvelopes();
-    
-    float gainA = std::clamp(_velocity * _gainA.getCurrentGain(), 0.0f, 1.0f);
-    float gainB = std::clamp(_velocity * _gainB.getCurrentGain(), 0.0f, 1.0f);
-    float gainSub = std::clamp(_velocity * _gainSub.getCurrentGain(), 0.0f, 1.0f);
-    
-    setOscillatorGains(gainA, gainB, gainSub);
-    _active = true;
-}
-
-void Voice::stopNote(float /* velocity */, bool allowTailOff)
-{
-    if (allowTailOff)
-    {
-        deactivateEnvelopes(); // Start release phase
-    }
-    else
-    {
-        prepareForReuse(); // Kill the voice
-        resetEnvelopes();
-    }
-}
-
-
-void Voice::renderNextSample(float& outputSample)
-{
-    _lastAmplitudeEnvSample = _amplitudeEnvelope.getNextSample();
-    if (_lastAmplitudeEnvSample > 0.0001f)
-    {
-        outputSample = getNextSampleSummed() * _lastAmplitudeEnvSample;
-    }
-    else
-    {
-        prepareForReuse();
-        outputSample = 0.0f;
-        return;
-    }
-    
-    if (_modulationEnvelope.isActive())
-    {
-        _lastModulationEnvSample = _modulationEnvelope.getNextSample(); // TODO: Implement modulation...
-    }
-    else
-    {
-        _lastModulationEnvSample = 0.0f;
-        _modulationEnvelope.reset();
-    }
-}
-
-bool Voice::isActive() const
-{
-    return _active;
-}
-
-void Voice::prepareForReuse()
-{
-    _midiNote = -1;
-    _previousMidiNote = -1;
-    _active = false;
-    _velocity = 0.0f;
-    
-    _lastAmplitudeEnvSample = 0.0f;
-    _lastModulationEnvSample = 0.0f;
-    
-    setOscillatorGains(0.0f, 0.0f, 0.0f);
-}
-
-void Voice::setSampleRate(double sampleRate)
-{
-    _sampleRate = sampleRate;
-}
-
-void Voice::setEnvelopeParams(juce::ADSR::Parameters& amplitudeEnvParams, juce::ADSR::Parameters& modulationEnvParams)
-{
-    _amplitudeEnvelopeParams = amplitudeEnvParams;
-    _modulationEnvelopeParams = modulationEnvParams;
-    _amplitudeEnvelope.setParameters(amplitudeEnvParams);
-    _modulationEnvelope.setParameters(modulationEnvParams);
-}
-
-OscillatorUtils::WaveType Voice::getOscillatorAType() const { return _oscillatorA.getWaveType(); }
-OscillatorUtils::WaveType Voice::getOscillatorBType() const { return _oscillatorB.getWaveType(); }
-OscillatorUtils::WaveType Voice::getOscillatorSubType() const { return _oscillatorSub.getWaveType(); }
-
-void Voice::setOscillatorTypes(OscillatorUtils::WaveType typeA, OscillatorUtils::WaveType typeB, OscillatorUtils::WaveType typeSub)
-{
-    _oscillatorA.setWaveType(typeA);
-    _oscillatorB.setWaveType(typeB);
-    _oscillatorSub.setWaveType(typeSub);
-}
-
-void Voice::setOscillatorAType(OscillatorUtils::WaveType type)
-{
-    _oscillatorA.setWaveType(type);
-}
-
-void Voice::setOscillatorBType(OscillatorUtils::WaveType type)
-{
-    _oscillatorB.setWaveType(type);
-}
-
-void Voice::setOscillatorSubType(OscillatorUtils::WaveType type)
-{
-    _oscillatorSub.setWaveType(type);
-}
-
-void Voice::setOscillatorSubOffset(OscillatorUtils::OctaveOffset offset)
-{
-    _oscillatorSubOffset = offset;
-    auto frequencySub = OscillatorUtils::applyOctaveOffset(_currentFrequency, _oscillatorSubOffset);
-    _oscillatorSub.setFrequency(frequencySub, _sampleRate);
-}
-
-void Voice::setPitchBend(float normalizedOffset)
-{
-    _pitchBendSemitoneOffset = std::clamp(normalizedOffset, -1.0f, 1.0f) * _pitchBendRange;
-    updateOscillatorFrequencies(std::nullopt);
-}
-
-void Voice::setPitchBendRange(float semitones)
-{
-    _pitchBendRange = std::clamp(semitones, 0.0f, 48.0f); // e.g. up to 4 octaves in semitones;
-    updateOscillatorFrequencies(std::nullopt);
-}
-
-void Voice::controllerMoved(int controllerNumber, int newValue)
-{
-    if (controllerNumber == 1) // Mod wheel
-    {
-        auto normalized = std::clamp(static_cast<float>(newValue) / 127.0f, 0.0f, 1.0f);
-        _modWheelDepth = normalized;
-    }
-}
-
-int Voice::getMidiNote() const { return _midiNote; }
-
-float Voice::getAmplitudeEnvelopeValue() const { return _lastAmplitudeEnvSample; }
-float Voice::getModulationEnvelopeValue() const { return _lastModulationEnvSample; }
-
-juce::ADSR::Parameters Voice::getAmplitudeEnvelopeParams() const { return _amplitudeEnvelopeParams; }
-void Voice::setAmplitudeEnvelopeParams(const juce::ADSR::Parameters &params)
-{
-    _amplitudeEnvelopeParams = params;
-    _amplitudeEnvelope.setParameters(params);
-}
-
-juce::ADSR::Parameters Voice::getModulationEnvelopeParams() const { return _modulationEnvelopeParams; }
-void Voice::setModulationEnvelopeParams(const juce::ADSR::Parameters &params)
-{
-    _modulationEnvelopeParams = params;
-    _modulationEnvelope.setParameters(params);
-}
-
-void Voice::setOscillatorAGain(float gain, float rampTimeSeconds)
-{
-    _gainA.setTargetGain(gain, rampTimeSeconds, _sampleRate);
-}
-
-void Voice::setOscillatorBGain(float gain, float rampTimeSeconds)
-{
-    _gainB.setTargetGain(gain, rampTimeSeconds, _sampleRate);
-}
-
-void Voice::setOscillatorSubGain(float gain, float rampTimeSeconds)
-{
-    _gainSub.setTargetGain(gain, rampTimeSeconds, _sampleRate);
-}
-
-void Voice::setOscillatorGains(float gainA, float gainB, float gainSub, float rampTimeSeconds)
-{
-    _gainA.setTargetGain(gainA, rampTimeSeconds, _sampleRate);
-    _gainB.setTargetGain(gainB, rampTimeSeconds, _sampleRate);
-    _gainSub.setTargetGain(gainSub, rampTimeSeconds, _sampleRate);
-}
-
-void Voice::setOscillatorGains(float gainA, float gainB, float gainSub)
-{
-    _gainA.setTargetGain(gainA, _gainRampTimeSeconds, _sampleRate);
-    _gainB.setTargetGain(gainB, _gainRampTimeSeconds, _sampleRate);
-    _gainSub.setTargetGain(gainSub, _gainRampTimeSeconds, _sampleRate);
-}
+/*
+  ==============================================================================
+
+    Voice.cpp
+    Created: 17 May 2025 11:00:53am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Utils/MidiUtils.h"
+#include "../Utils/FastMathUtils.h"
+#include "../Utils/GainUtils.h"
+#include "../Oscillator/Oscillator.h"
+#include "Voice.h"
+
+// Constructors
+Voice::Voice()
+{
+    initialiseDefaults();
+}
+
+// Private methods
+void Voice::initialiseDefaults()
+{
+    // Oscillators
+    initialiseOscillators(OscillatorUtils::WaveType::Sine,
+                          OscillatorUtils::WaveType::Sine,
+                          OscillatorUtils::WaveType::Sine,
+                          OscillatorUtils::OctaveOffset::One);
+    
+    // Envelopes
+    resetEnvelopes();
+    
+    // Gains
+    setOscillatorGains(0.0f, 0.0f, 0.0f);
+}
+
+void Voice::updateOscillatorFrequencies(std::optional<int> midiNote)
+{
+    auto note = midiNote.value_or((_midiNote >= 0 ? _midiNote : _previousMidiNote));
+    if (note < 0 || _tuning == nullptr)
+    {
+        _currentFrequency = 0.0f;
+    }
+    else
+    {
+        _noteFrequency = std::clamp(_tuning->getNoteFrequency(note) * _glideFactor, 0.0f, 20000.0f);
+        _currentFrequency = _noteFrequency * _pitchBendFactor * _notePitchBendFactor;
+        if (_midiNote >= 0)
+        {
+            _previousMidiNote = _midiNote;
+        }
+    }
+    
+    _oscillatorA.setFrequency(_currentFrequency, _sampleRate);
+    _oscillatorB.setFrequency(_currentFrequency, _sampleRate);
+    
+    auto subFreq = OscillatorUtils::applyOctaveOffset(_currentFrequency, _oscillatorSubOffset);
+    _oscillatorSub.setFrequency(subFreq, _sampleRate);
+}
+
+void Voice:: setEnvelopeSampleRate(double sampleRate)
+{
+    _amplitudeEnvelope.setSampleRate(sampleRate);
+    _modulationEnvelope.setSampleRate(sampleRate);
+}
+
+void Voice::resetEnvelopes()
+{
+    // Assign them to the envelopes
+    _amplitudeEnvelope.setParameters(_amplitudeEnvelopeParams);
+    _modulationEnvelope.setParameters(_modulationEnvelopeParams);
+    
+    // Reset the envelopes
+    _amplitudeEnvelope.reset();
+    _modulationEnvelope.reset();
+}
+
+void Voice::initialiseOscillators(OscillatorUtils::WaveType typeA,
+                                  OscillatorUtils::WaveType typeB,
+                                  OscillatorUtils::WaveType typeSub,
+                                  OscillatorUtils::OctaveOffset oscillatorSubOffset)
+{
+    // Set oscillator types and offset amount
+    setOscillatorTypes(typeA, typeB, typeSub);
+    setOscillatorSubOffset(oscillatorSubOffset);
+    
+    // Set default pulse width for square waves
+    _oscillatorA.setPulseWidth(0.5f);
+    _oscillatorB.setPulseWidth(0.5f);
+    _oscillatorSub.setPulseWidth(0.5f);
+    
+    // Reset phase
+    _oscillatorA.resetPhase();
+    _oscillatorB.resetPhase();
+    _oscillatorSub.resetPhase();
+}
+
+void Voice::activateEnvelopes()
+{
+    _released = false;
+    _hasBecomeAudible = false;
+    _amplitudeEnvelope.noteOn();
+    _modulationEnvelope.noteOn();
+}
+
+void Voice::deactivateEnvelopes()
+{
+    _released = true;
+    _amplitudeEnvelope.noteOff();
+    _modulationEnvelope.noteOff();
+}
+
+// Sum the gained oscillators for the block into the mix channel
+void Voice::renderOscillators(int numSamples)
+{
+    auto mixHasContent = false;
+    mixOscillator(_oscillatorA, _gainA, numSamples, mixHasContent);
+    mixOscillator(_oscillatorB, _gainB, numSamples, mixHasContent);
+    mixOscillator(_oscillatorSub, _gainSub, numSamples, mixHasContent);
+    
+    if (!mixHasContent)
+    {
+        juce::FloatVectorOperations::clear(_renderBuffer.getWritePointer(_mixChannel), numSamples);
+    }
+}
+
+// Oscillators whose gain has settled at zero aren't rendered, only advanced so they fade back in cleanly
+void Voice::mixOscillator(Oscillator& oscillator, Gain& gain, int numSamples, bool& mixHasContent)
+{
+    if (gain.isSilent())
+    {
+        oscillator.advance(numSamples);
+        return;
+    }
+    
+    auto* mix = _renderBuffer.getWritePointer(_mixChannel);
+    auto* output = mixHasContent ? _renderBuffer.getWritePointer(_oscillatorChannel) : mix;
+    oscillator.processBlock(output, numSamples);
+    gain.processBlock(output, numSamples);
+    
+    if (mixHasContent)
+    {
+        juce::FloatVectorOperations::add(mix, output, numSamples);
+    }
+    
+    mixHasContent = true;
+}
+
+// Applies the envelopes to the mix and returns how many samples were rendered before the voice finished
+int Voice::applyEnvelopes(int numSamples)
+{
+    auto* mix = _renderBuffer.getWritePointer(_mixChannel);
+    
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        _lastAmplitudeEnvSample = _amplitudeEnvelope.getNextSample();
+        if (_lastAmplitudeEnvSample >= _silenceThreshold)
+        {
+            _hasBecomeAudible = true;
+        }
+        
+        // Once the release (or a decay to zero sustain) drops below the threshold the rest is inaudible,
+        // so end the voice rather than render near-zero samples. A slow attack starting below it must not count.
+        const bool tailFinished = (_released || _hasBecomeAudible) && _lastAmplitudeEnvSample < _silenceThreshold;
+        if (tailFinished || !_amplitudeEnvelope.isActive())
+        {
+            prepareForReuse();
+            return i;
+        }
+        
+        mix[i] *= _lastAmplitudeEnvSample;
+        
+        if (_modulationEnvelope.isActive())
+        {
+            _lastModulationEnvSample = _modulationEnvelope.getNextSample(); // TODO: Implement modulation...
+            if (_lastModulationEnvSample < _silenceThreshold)
+            {
+                _lastModulationEnvSample = 0.0f;
+            }
+        }
+        else
+        {
+            _lastModulationEnvSample = 0.0f;
+            _modulationEnvelope.reset();
+        }
+    }
+    
+    return numSamples;
+}
+
+// Initialisation
+void Voice::prepare(double sampleRate, int samplePerBlock, int numChannels)
+{
+    if (_sampleRate != sampleRate)
+    {
+        _sampleRate = sampleRate;
+        setEnvelopeSampleRate(sampleRate);
+    }
+    
+    _renderBuffer.setSize(_numRenderChannels, std::max(1, samplePerBlock));
+    _notePitchBend.reset(sampleRate, _expressionSmoothingSeconds);
+    _timbre.reset(sampleRate, _expressionSmoothingSeconds);
+    _saturator.prepare(sampleRate);
+    
+    int note = (_midiNote >= 0) ? _midiNote : _previousMidiNote;
+    float gainA = (note >= 0) ? std::clamp(_velocity * _gainA.getCurrentGain(), 0.0f, 1.0f) : 0.0f;
+    float gainB = (note >= 0) ? std::clamp(_velocity * _gainB.getCurrentGain(), 0.0f, 1.0f) : 0.0f;
+    float gainSub = (note >= 0) ? std::clamp(_velocity * _gainSub.getCurrentGain(), 0.0f, 1.0f) : 0.0f;
+
+    
+    updateOscillatorFrequencies(note);
+    setOscillatorGains(gainA, gainB, gainSub);
+}
+
+// Playback behaviour
+void Voice::startNote(int midiNote, float velocity)
+{
+    _midiNote = midiNote;
+    _velocity = velocity;
+    
+    stopGlide();
+    updateOscillatorFrequencies(_midiNote);
+    _oscillatorA.startNote(_midiNote);
+    _oscillatorB.startNote(_midiNote);
+    _oscillatorSub.startNote(_midiNote);
+    _saturator.reset();
+    _fadeOutGain.reset(1.0f);
+    _isFadingOut = false;
+    
+    activateEnvelopes();
+    
+    float gainA = std::clamp(_velocity * _gainA.getCurrentGain(), 0.0f, 1.0f);
+    float gainB = std::clamp(_velocity * _gainB.getCurrentGain(), 0.0f, 1.0f);
+    float gainSub = std::clamp(_velocity * _gainSub.getCurrentGain(), 0.0f, 1.0f);
+    
+    setOscillatorGains(gainA, gainB, gainSub);
+    _active = true;
+}
+
+void Voice::stopNote(float /* velocity */, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        deactivateEnvelopes(); // Start release phase
+    }
+    else
+    {
+        prepareForReuse(); // Kill the voice
+        resetEnvelopes();
+    }
+}
+
+void Voice::fadeOut()
+{
+    if (!_active || _isFadingOut)
+        return;
+    
+    _isFadingOut = true;
+    _fadeOutGain.setTargetGain(0.0f, _fadeOutSeconds, _sampleRate);
+}
+
+void Voice::changeNote(int midiNote)
+{
+    _midiNote = midiNote;
+    stopGlide();
+    updateOscillatorFrequencies(_midiNote);
+}
+
+void Voice::startGlide(float fromFrequency, float glideSeconds, bool constantRate)
+{
+    stopGlide();
+    const auto targetFrequency = _tuning != nullptr ? _tuning->getNoteFrequency(_midiNote) : 0.0f;
+    if (fromFrequency <= 0.0f || targetFrequency <= 0.0f || glideSeconds <= 0.0f)
+        return;
+    
+    const auto octaves = std::log2(fromFrequency / targetFrequency);
+    const auto glideSamples = glideSeconds * static_cast<float>(_sampleRate) * (constantRate ? std::abs(octaves) : 1.0f);
+    if (glideSamples < 1.0f)
+        return;
+    
+    _glideOctaves = octaves;
+    _glideOctavesPerSample = octaves / glideSamples;
+    _glideFactor = FastMathUtils::exp2(_glideOctaves);
+    updateOscillatorFrequencies(std::nullopt);
+}
+
+float Voice::getNoteFrequency() const
+{
+    return _noteFrequency;
+}
+
+void Voice::setExpression(float pitchBendSemitones, float pressure, float timbre, bool immediate)
+{
+    const auto pressureGain = _pressureGainFloor + (1.0f - _pressureGainFloor) * std::clamp(pressure, 0.0f, 1.0f);
+    timbre = std::clamp(timbre, 0.0f, 1.0f);
+    
+    if (immediate)
+    {
+        _notePitchBend.setCurrentAndTargetValue(pitchBendSemitones);
+        _timbre.setCurrentAndTargetValue(timbre);
+        _pressureGain.reset(pressureGain);
+        advanceControlRate(0);
+    }
+    else
+    {
+        // Only targets are set here, the voice catches up at control rate
+        _notePitchBend.setTargetValue(pitchBendSemitones);
+        _timbre.setTargetValue(timbre);
+        _pressureGain.setTargetGain(pressureGain, static_cast<float>(_expressionSmoothingSeconds), _sampleRate);
+    }
+}
+
+bool Voice::isControlRateActive() const
+{
+    return _glideOctaves != 0.0f || _notePitchBend.isSmoothing() || _timbre.isSmoothing();
+}
+
+// Steps glide and expression once per control block and retunes the oscillators
+void Voice::advanceControlRate(int numSamples)
+{
+    if (_glideOctaves != 0.0f)
+    {
+        const auto step = _glideOctavesPerSample * static_cast<float>(numSamples);
+        _glideOctaves = std::abs(step) >= std::abs(_glideOctaves) ? 0.0f : _glideOctaves - step;
+        _glideFactor = FastMathUtils::exp2(_glideOctaves);
+    }
+    
+    const auto pitchBend = _notePitchBend.skip(numSamples);
+    _notePitchBendFactor = pitchBend != 0.0f ? FastMathUtils::semitonesToRatio(pitchBend) : 1.0f;
+    
+    const auto pulseWidth = 0.5f + _maxPulseWidthOffset * (2.0f * _timbre.skip(numSamples) - 1.0f);
+    _oscillatorA.setPulseWidth(pulseWidth);
+    _oscillatorB.setPulseWidth(pulseWidth);
+    
+    updateOscillatorFrequencies(std::nullopt);
+}
+
+void Voice::stopGlide()
+{
+    _glideOctaves = 0.0f;
+    _glideOctavesPerSample = 0.0f;
+    _glideFactor = 1.0f;
+}
+
+// Adds the voice to every channel of the output buffer. Larger blocks than prepared
+// are rendered in chunks so nothing is allocated here.
+void Voice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    const auto maxBlockSize = _renderBuffer.getNumSamples();
+    jassert(maxBlockSize > 0); // prepare() hasn't been called
+    
+    while (_active && numSamples > 0 && maxBlockSize > 0)
+    {
+        // While gliding or following expression the oscillators are retuned every control block
+        const auto isModulating = isControlRateActive();
+        const auto blockSize = std::min(numSamples, isModulating ? std::min(maxBlockSize, _controlBlockSize) : maxBlockSize);
+        renderOscillators(blockSize);
+        if (isModulating)
+        {
+            advanceControlRate(blockSize);
+        }
+        
+        if (_pressureGain.isRamping() || _pressureGain.getCurrentGain() != 1.0f)
+        {
+            _pressureGain.processBlock(_renderBuffer.getWritePointer(_mixChannel), blockSize);
+        }
+        
+        _saturator.processBlock(_renderBuffer.getWritePointer(_mixChannel), blockSize);
+        
+        const auto numRendered = applyEnvelopes(blockSize);
+        if (_isFadingOut)
+        {
+            _fadeOutGain.processBlock(_renderBuffer.getWritePointer(_mixChannel), numRendered);
+        }
+        
+        for (auto channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+        {
+            outputBuffer.addFrom(channel, startSample, _renderBuffer, _mixChannel, 0, numRendered);
+        }
+        
+        // The fade lands on exact zero, so the voice ends at a block boundary without a step
+        if (_isFadingOut && _fadeOutGain.isSilent())
+        {
+            prepareForReuse();
+        }
+        
+        startSample += blockSize;
+        numSamples -= blockSize;
+    }
+}
+
+bool Voice::isActive() const
+{
+    return _active;
+}
+
+bool Voice::isReleasing() const
+{
+    return _active && _released;
+}
+
+void Voice::prepareForReuse()
+{
+    _midiNote = -1;
+    _previousMidiNote = -1;
+    _active = false;
+    _released = false;
+    _hasBecomeAudible = false;
+    _isFadingOut = false;
+    _velocity = 0.0f;
+    
+    _lastAmplitudeEnvSample = 0.0f;
+    _lastModulationEnvSample = 0.0f;
+    
+    setOscillatorGains(0.0f, 0.0f, 0.0f);
+    
+    // Hands any streams back to the pool
+    _oscillatorA.stopNote();
+    _oscillatorB.stopNote();
+    _oscillatorSub.stopNote();
+}
+
+// For a sounding voice changing rate, such as when the oversampling factor changes. Unlike prepare, the
+// gains, envelope stages and saturator history carry on and only the per-sample steps are recomputed
+void Voice::setSampleRate(double sampleRate)
+{
+    if (_sampleRate == sampleRate)
+        return;
+    
+    _glideOctavesPerSample *= static_cast<float>(_sampleRate / sampleRate);
+    _sampleRate = sampleRate;
+    setEnvelopeSampleRate(sampleRate);
+    GainUtils::setSmoothedValueSampleRate(_notePitchBend, sampleRate, _expressionSmoothingSeconds);
+    GainUtils::setSmoothedValueSampleRate(_timbre, sampleRate, _expressionSmoothingSeconds);
+    _saturator.setSampleRate(sampleRate);
+    updateOscillatorFrequencies(std::nullopt);
+}
+
+void Voice::setEnvelopeParams(juce::ADSR::Parameters& amplitudeEnvParams, juce::ADSR::Parameters& modulationEnvParams)
+{
+    _amplitudeEnvelopeParams = amplitudeEnvParams;
+    _modulationEnvelopeParams = modulationEnvParams;
+    _amplitudeEnvelope.setParameters(amplitudeEnvParams);
+    _modulationEnvelope.setParameters(modulationEnvParams);
+}
+
+OscillatorUtils::WaveType Voice::getOscillatorAType() const { return _oscillatorA.getWaveType(); }
+OscillatorUtils::WaveType Voice::getOscillatorBType() const { return _oscillatorB.getWaveType(); }
+OscillatorUtils::WaveType Voice::getOscillatorSubType() const { return _oscillatorSub.getWaveType(); }
+
+void Voice::setOscillatorTypes(OscillatorUtils::WaveType typeA, OscillatorUtils::WaveType typeB, OscillatorUtils::WaveType typeSub)
+{
+    _oscillatorA.setWaveType(typeA);
+    _oscillatorB.setWaveType(typeB);
+    _oscillatorSub.setWaveType(typeSub);
+}
+
+void Voice::setOscillatorAType(OscillatorUtils::WaveType type)
+{
+    _oscillatorA.setWaveType(type);
+}
+
+void Voice::setOscillatorBType(OscillatorUtils::WaveType type)
+{
+    _oscillatorB.setWaveType(type);
+}
+
+void Voice::setOscillatorSubType(OscillatorUtils::WaveType type)
+{
+    _oscillatorSub.setWaveType(type);
+}
+
+void Voice::setOscillatorSubOffset(OscillatorUtils::OctaveOffset offset)
+{
+    _oscillatorSubOffset = offset;
+    auto frequencySub = OscillatorUtils::applyOctaveOffset(_currentFrequency, _oscillatorSubOffset);
+    _oscillatorSub.setFrequency(frequencySub, _sampleRate);
+}
+
+void Voice::setTuning(const TuningTable* tuning)
+{
+    _tuning = tuning;
+    updateOscillatorFrequencies(std::nullopt);
+}
+
+void Voice::setPitchBendFactor(float factor)
+{
+    if (factor == _pitchBendFactor)
+        return;
+    
+    _pitchBendFactor = factor;
+    updateOscillatorFrequencies(std::nullopt);
+}
+
+void Voice::setControlBlockSize(int numSamples)
+{
+    _controlBlockSize = std::max(1, numSamples);
+}
+
+void Voice::setSampleStreamer(SampleStreamer* streamer)
+{
+    _oscillatorA.setSampleStreamer(streamer);
+    _oscillatorB.setSampleStreamer(streamer);
+    _oscillatorSub.setSampleStreamer(streamer);
+}
+
+void Voice::setDrive(float amount, EngineUtils::SaturationShape shape)
+{
+    _saturator.setShape(shape);
+    _saturator.setDrive(amount);
+}
+
+void Voice::setDriveInputLevel(float level)
+{
+    _saturator.setInputLevel(level);
+}
+
+void Voice::controllerMoved(int controllerNumber, int newValue)
+{
+    if (controllerNumber == 1) // Mod wheel
+    {
+        auto normalized = std::clamp(static_cast<float>(newValue) / 127.0f, 0.0f, 1.0f);
+        _modWheelDepth = normalized;
+    }
+}
+
+int Voice::getMidiNote() const { return _midiNote; }
+
+float Voice::getAmplitudeEnvelopeValue() const { return _lastAmplitudeEnvSample; }
+float Voice::getModulationEnvelopeValue() const { return _lastModulationEnvSample; }
+
+juce::ADSR::Parameters Voice::getAmplitudeEnvelopeParams() const { return _amplitudeEnvelopeParams; }
+void Voice::setAmplitudeEnvelopeParams(const juce::ADSR::Parameters &params)
+{
+    _amplitudeEnvelopeParams = params;
+    _amplitudeEnvelope.setParameters(params);
+}
+
+juce::ADSR::Parameters Voice::getModulationEnvelopeParams() const { return _modulationEnvelopeParams; }
+void Voice::setModulationEnvelopeParams(const juce::ADSR::Parameters &params)
+{
+    _modulationEnvelopeParams = params;
+    _modulationEnvelope.setParameters(params);
+}
+
+void Voice::setOscillatorAGain(float gain, float rampTimeSeconds)
+{
+    _gainA.setTargetGain(gain, rampTimeSeconds, _sampleRate);
+}
+
+void Voice::setOscillatorBGain(float gain, float rampTimeSeconds)
+{
+    _gainB.setTargetGain(gain, rampTimeSeconds, _sampleRate);
+}
+
+void Voice::setOscillatorSubGain(float gain, float rampTimeSeconds)
+{
+    _gainSub.setTargetGain(gain, rampTimeSeconds, _sampleRate);
+}
+
+void Voice::setOscillatorGains(float gainA, float gainB, float gainSub, float rampTimeSeconds)
+{
+    _gainA.setTargetGain(gainA, rampTimeSeconds, _sampleRate);
+    _gainB.setTargetGain(gainB, rampTimeSeconds, _sampleRate);
+    _gainSub.setTargetGain(gainSub, rampTimeSeconds, _sampleRate);
+}
+
+void Voice::setOscillatorGains(float gainA, float gainB, float gainSub)
+{
+    _gainA.setTargetGain(gainA, _gainRampTimeSeconds, _sampleRate);
+    _gainB.setTargetGain(gainB, _gainRampTimeSeconds, _sampleRate);
+    _gainSub.setTargetGain(gainSub, _gainRampTimeSeconds, _sampleRate);
+}
@@ -1,123 +1,171 @@
-/*
-  ==============================================================================
-
-    Voice.h
-    Created: 17 May 2025 11:00:53am
-    Author:  Joshua Navon
-
-  ==============================================================================
-*/
-
-#pragma once
-#include <string>
-#include <JuceHeader.h>
-#include "../Oscillator/Oscillator.h"
-#include "../Utils/OscillatorUtils.h"
-#include "../Gain/Gain.h"
-
-class Voice
-{
-public:
-    // Constructors / Destructors
-    Voice();
-    ~Voice() = default;
-    
-    // Initializing methods
-    void prepare(double sampleRate, int samplePerBlock, int numChannels);
-    
-    // Playback
-    void startNote(int midiNote, float velocity);
-    void stopNote(float velocity, bool allowTailOff);
-    void renderNextSample(float& outputSample);
-    
-    void prepareForReuse();
-    bool isActive() const;
-    
-    void setSampleRate(double sampleRate);
-    void setEnvelopeParams(juce::ADSR::Parameters& amplitudeEnvParams, juce::ADSR::Parameters& modulationEnvParams);
-    void setPitchBend(float semitoneOffset);
-    void setPitchBendRange(float semitones);
-    void controllerMoved(int controllerNumber, int newValue);
-    int getMidiNote() const;
-    
-    // Oscillator methods
-    OscillatorUtils::WaveType getOscillatorAType() const;
-    OscillatorUtils::WaveType getOscillatorBType() const;
-    OscillatorUtils::WaveType getOscillatorSubType() const;
-    void setOscillatorTypes(OscillatorUtils::WaveType typeA, OscillatorUtils::WaveType typeB, OscillatorUtils::WaveType typeSub);
-    void setOscillatorAType(OscillatorUtils::WaveType type);
-    void setOscillatorBType(OscillatorUtils::WaveType type);
-    void setOscillatorSubType(OscillatorUtils::WaveType type);
-    void setOscillatorSubOffset(OscillatorUtils::OctaveOffset offset);
-    
-    // Envelope methods
-    juce::ADSR::Parameters getAmplitudeEnvelopeParams() const;
-    juce::ADSR::Parameters getModulationEnvelopeParams() const;
-    void setAmplitudeEnvelopeParams(const juce::ADSR::Parameters& params);
-    void setModulationEnvelopeParams(const juce::ADSR::Parameters& params);
-    
-    float getAmplitudeEnvelopeValue() const;
-    float getModulationEnvelopeValue() const;
-    
-    // Gain methods
-    void setOscillatorAGain(float gain, float rampTimeInSeconds);
-    void setOscillatorBGain(float gain, float rampTimeInSeconds);
-    void setOscillatorSubGain(float gain, float rampTimeInSeconds);
-    void setOscillatorGains(float gainA, float gainB, float gainSub, float rampTimeSeconds);
-    
-private:
-    // Oscillators
-    Oscillator _oscillatorA;
-    Oscillator _oscillatorB;
-    Oscillator _oscillatorSub;
-    OscillatorUtils::OctaveOffset _oscillatorSubOffset = OscillatorUtils::OctaveOffset::One;
-    
-    // Envelopes
-    juce::ADSR _amplitudeEnvelope;
-    juce::ADSR::Parameters _amplitudeEnvelopeParams;
-    float _lastAmplitudeEnvSample = 0.0f;
-    juce::ADSR _modulationEnvelope;
-    juce::ADSR::Parameters _modulationEnvelopeParams;
-    float _lastModulationEnvSample = 0.0f;
-    
-    // Gain
-    Gain _gainA;
-    Gain _gainB;
-    Gain _gainSub;
-    
-    // Note info
-    bool _active = false;
-    float _currentFrequency = 440.0f;
-    int _midiNote = -1;
-    int _previousMidiNote = -1;
-    float _pitchBendSemitoneOffset = 0.0f;
-    float _pitchBendRange = 2.0f;
-    float _modWheelDepth = 0.0f;
-    
-    std::string _noteNameWithEnharmonics = "";
-    double _sampleRate = 44100.0;
-    float _velocity = 1.0f;
-    
-    // Constants
-    static constexpr float _gainRampTimeSeconds = 0.025f;
-    
-    // Helpers
-    void initialiseDefaults();
-    void updateOscillatorFrequencies(std::optional<int> midiNote);
-    void setEnvelopeSampleRate(double sampleRate);
-    void setOscillatorGains(float gainA, float gainB, float gainSub);
-    void setOscillatorGains(float gain, float rampTimeInSeconds);
-    void resetEnvelopes();
-    void deactivateEnvelopes();
-    void activateEnvelopes();
-    float getNextSampleSummed();
-    float getNextSample(Oscillator& oscillator, Gain& gain);
-    void processGains(float& sample);
-    void initialiseOscillators(OscillatorUtils::WaveType typeA,
-                               OscillatorUtils::WaveType typeB,
-                               OscillatorUtils::WaveType typeSub,
-                               OscillatorUtils::OctaveOffset oscillatorSubOffset);
-    
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Voice)
-};
+/*
+  ==============================================================================
+
+    Voice.h
+    Created: 17 May 2025 11:00:53am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <string>
+#include <JuceHeader.h>
+#include "../Oscillator/Oscillator.h"
+#include "../Utils/OscillatorUtils.h"
+#include "../Gain/Gain.h"
+#include "../Saturator/Saturator.h"
+#include "../Tuning/TuningTable.h"
+
+class Voice
+{
+public:
+    // Constructors / Destructors
+    Voice();
+    ~Voice() = default;
+    
+    // Initializing methods
+    void prepare(double sampleRate, int samplePerBlock, int numChannels);
+    
+    // Playback
+    void startNote(int midiNote, float velocity);
+    void stopNote(float velocity, bool allowTailOff);
+    void fadeOut(); // Ends the voice over a few milliseconds, quicker than any release but without a click
+    void changeNote(int midiNote); // Legato, the envelopes carry on
+    void startGlide(float fromFrequency, float glideSeconds, bool constantRate);
+    float getNoteFrequency() const; // Tuned note frequency with any glide applied, before pitch bend
+    
+    // Per-note expression (MPE): bend in semitones, pressure and timbre in [0, 1]. Smoothed unless immediate
+    void setExpression(float pitchBendSemitones, float pressure, float timbre, bool immediate);
+    void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    
+    void prepareForReuse();
+    bool isActive() const;
+    bool isReleasing() const; // Key released and the envelope tailing off
+    
+    void setSampleRate(double sampleRate); // Retunes a sounding voice without resetting it
+    void setEnvelopeParams(juce::ADSR::Parameters& amplitudeEnvParams, juce::ADSR::Parameters& modulationEnvParams);
+    void setTuning(const TuningTable* tuning);
+    void setSampleStreamer(SampleStreamer* streamer); // For oscillators set to Sample
+    void setPitchBendFactor(float factor);
+    void setControlBlockSize(int numSamples);
+    void setDrive(float amount, EngineUtils::SaturationShape shape); // Shapes the oscillator mix ahead of the amplitude envelope
+    void setDriveInputLevel(float level); // The voice's level in the mix, which the drive treats as full scale
+    void controllerMoved(int controllerNumber, int newValue);
+    int getMidiNote() const;
+    
+    // Oscillator methods
+    OscillatorUtils::WaveType getOscillatorAType() const;
+    OscillatorUtils::WaveType getOscillatorBType() const;
+    OscillatorUtils::WaveType getOscillatorSubType() const;
+    void setOscillatorTypes(OscillatorUtils::WaveType typeA, OscillatorUtils::WaveType typeB, OscillatorUtils::WaveType typeSub);
+    void setOscillatorAType(OscillatorUtils::WaveType type);
+    void setOscillatorBType(OscillatorUtils::WaveType type);
+    void setOscillatorSubType(OscillatorUtils::WaveType type);
+    void setOscillatorSubOffset(OscillatorUtils::OctaveOffset offset);
+    
+    // Envelope methods
+    juce::ADSR::Parameters getAmplitudeEnvelopeParams() const;
+    juce::ADSR::Parameters getModulationEnvelopeParams() const;
+    void setAmplitudeEnvelopeParams(const juce::ADSR::Parameters& params);
+    void setModulationEnvelopeParams(const juce::ADSR::Parameters& params);
+    
+    float getAmplitudeEnvelopeValue() const;
+    float getModulationEnvelopeValue() const;
+    
+    // Gain methods
+    void setOscillatorAGain(float gain, float rampTimeInSeconds);
+    void setOscillatorBGain(float gain, float rampTimeInSeconds);
+    void setOscillatorSubGain(float gain, float rampTimeInSeconds);
+    void setOscillatorGains(float gainA, float gainB, float gainSub, float rampTimeSeconds);
+    
+private:
+    // Oscillators
+    Oscillator _oscillatorA;
+    Oscillator _oscillatorB;
+    Oscillator _oscillatorSub;
+    OscillatorUtils::OctaveOffset _oscillatorSubOffset = OscillatorUtils::OctaveOffset::One;
+    
+    // Envelopes
+    juce::ADSR _amplitudeEnvelope;
+    juce::ADSR::Parameters _amplitudeEnvelopeParams;
+    float _lastAmplitudeEnvSample = 0.0f;
+    juce::ADSR _modulationEnvelope;
+    juce::ADSR::Parameters _modulationEnvelopeParams;
+    float _lastModulationEnvSample = 0.0f;
+    
+    // Render scratch space, sized in prepare()
+    juce::AudioBuffer<float> _renderBuffer;
+    static constexpr int _mixChannel = 0;
+    static constexpr int _oscillatorChannel = 1;
+    static constexpr int _numRenderChannels = 2;
+    
+    // Gain
+    Gain _gainA;
+    Gain _gainB;
+    Gain _gainSub;
+    Gain _fadeOutGain;
+    bool _isFadingOut = false;
+    
+    // Note info
+    bool _active = false;
+    bool _released = false;
+    bool _hasBecomeAudible = false;
+    float _currentFrequency = 440.0f;
+    int _midiNote = -1;
+    int _previousMidiNote = -1;
+    float _pitchBendFactor = 1.0f; // Set by the engine, shared by all voices
+    float _noteFrequency = 0.0f;
+    
+    // Glide runs linearly in octaves (exponentially in Hz) and is stepped per control block
+    float _glideOctaves = 0.0f; // Offset from the note, 0 when not gliding
+    float _glideOctavesPerSample = 0.0f;
+    float _glideFactor = 1.0f;
+    
+    // Per-note expression. Bend and timbre are stepped per control block, pressure ramps per sample
+    juce::SmoothedValue<float> _notePitchBend = 0.0f; // Semitones
+    juce::SmoothedValue<float> _timbre = 0.5f;
+    Gain _pressureGain;
+    Saturator _saturator;
+    float _notePitchBendFactor = 1.0f;
+    static constexpr double _expressionSmoothingSeconds = 0.01;
+    static constexpr float _pressureGainFloor = 0.5f; // Gain with no pressure, full pressure is unity
+    static constexpr float _maxPulseWidthOffset = 0.4f; // Timbre 0 and 1 reach pulse widths of 0.1 and 0.9
+    
+    int _controlBlockSize = 32; // Set from the engine's render quality
+    const TuningTable* _tuning = nullptr; // Owned by the engine
+    float _modWheelDepth = 0.0f;
+    
+    std::string _noteNameWithEnharmonics = "";
+    double _sampleRate = 44100.0;
+    float _velocity = 1.0f;
+    
+    // Constants
+    static constexpr float _gainRampTimeSeconds = 0.025f;
+    static constexpr float _fadeOutSeconds = 0.003f;
+    static constexpr float _silenceThreshold = 0.0001f; // -80dB, envelope values below this end the tail
+    
+    // Helpers
+    void initialiseDefaults();
+    void updateOscillatorFrequencies(std::optional<int> midiNote);
+    void advanceControlRate(int numSamples);
+    bool isControlRateActive() const;
+    void stopGlide();
+    void setEnvelopeSampleRate(double sampleRate);
+    void setOscillatorGains(float gainA, float gainB, float gainSub);
+    void setOscillatorGains(float gain, float rampTimeInSeconds);
+    void resetEnvelopes();
+    void deactivateEnvelopes();
+    void activateEnvelopes();
+    void renderOscillators(int numSamples);
+    void mixOscillator(Oscillator& oscillator, Gain& gain, int numSamples, bool& mixHasContent);
+    int applyEnvelopes(int numSamples);
+    void processGains(float& sample);
+    void initialiseOscillators(OscillatorUtils::WaveType typeA,
+                               OscillatorUtils::WaveType typeB,
+                               OscillatorUtils::WaveType typeSub,
+                               OscillatorUtils::OctaveOffset oscillatorSubOffset);
+    
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Voice)
+};
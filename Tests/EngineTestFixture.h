@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    EngineTestFixture.h
+    Created: 28 Oct 2026 5:36:20pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Source/Engine/SynthEngine.h"
+#include "../Source/Engine/MultiTimbralEngine.h"
+
+// Base for the Engine category tests. They all play a plain sine patch that holds at full
+// level and render a quarter second after each set of messages, which lets releases run out.
+class EngineTestFixture : public juce::UnitTest
+{
+public:
+    explicit EngineTestFixture(const juce::String& name) : juce::UnitTest(name, "Engine") {}
+
+protected:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr juce::uint8 velocity = 100;
+
+    static void prepare(SynthEngine& engine)
+    {
+        engine.prepareToPlay(sampleRate, blockSize);
+        setPatch(engine);
+    }
+
+    // Every part gets the same patch
+    static void prepare(MultiTimbralEngine& engine)
+    {
+        engine.prepareToPlay(sampleRate, blockSize);
+        for (auto i = 0; i < MultiTimbralEngine::numParts; ++i)
+        {
+            setPatch(engine.getPart(i));
+        }
+    }
+
+    // Sends the messages, then renders a quarter second and returns the RMS level of its last block
+    template <typename Engine>
+    static float play(Engine& engine, juce::MidiBuffer midiMessages)
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        for (auto i = 0; i < static_cast<int>(0.25 * sampleRate / blockSize); ++i)
+        {
+            engine.processBlock(buffer, midiMessages);
+            midiMessages.clear();
+        }
+
+        return buffer.getRMSLevel(0, 0, blockSize);
+    }
+
+    template <typename Engine>
+    static float play(Engine& engine, std::initializer_list<juce::MidiMessage> messages)
+    {
+        juce::MidiBuffer midiMessages;
+        for (const auto& message : messages)
+        {
+            midiMessages.addEvent(message, 0);
+        }
+
+        return play(engine, midiMessages);
+    }
+
+private:
+    static void setPatch(SynthEngine& engine)
+    {
+        engine.setOscillatorAType(OscillatorUtils::WaveType::Sine);
+        engine.setOscillatorGains(1.0f, 0.0f, 0.0f);
+        engine.setAmplitudeEnvelopeParams({ 0.005f, 0.0f, 1.0f, 0.05f });
+        engine.setMasterGain(1.0f);
+    }
+};
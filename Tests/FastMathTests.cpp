@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    FastMathTests.cpp
+    Created: 26 Oct 2026 4:47:05pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/Utils/FastMathUtils.h"
+
+// Checks every FastMathUtils approximation against the double precision std version over
+// the domain its comment states, at the error its comment claims, then logs how long it
+// takes next to the std float version. Timings are only meaningful in a Release build.
+class FastMathTests : public juce::UnitTest
+{
+public:
+    FastMathTests() : juce::UnitTest("Fast maths", "Accuracy") {}
+
+    void runTest() override
+    {
+        constexpr auto pi = juce::MathConstants<double>::pi;
+
+        beginTest("sin");
+        {
+            const auto fast = [](float x) { return FastMathUtils::sin(x); };
+            const auto reference = [](double x) { return std::sin(x); };
+            expectMaxError("sin, |x| <= 2pi", fast, reference, -2.0 * pi, 2.0 * pi, Error::Absolute, 2.2e-7);
+            expectMaxError("sin, |x| <= 8pi", fast, reference, -8.0 * pi, 8.0 * pi, Error::Absolute, 7.1e-7);
+            expectMaxError("sin, |x| <= 64pi", fast, reference, -64.0 * pi, 64.0 * pi, Error::Absolute, 1.1e-5);
+            logTimings("sin", fast, [](float x) { return std::sin(x); }, -2.0f * juce::MathConstants<float>::pi, 2.0f * juce::MathConstants<float>::pi);
+        }
+
+        beginTest("exp2");
+        {
+            const auto fast = [](float x) { return FastMathUtils::exp2(x); };
+            expectMaxError("exp2", fast, [](double x) { return std::exp2(x); }, -126.0, 127.0, Error::Relative, 1.7e-7);
+            expectWithinAbsoluteError(FastMathUtils::exp2(-1000.0f) / std::exp2(-126.0f), 1.0f, 1.7e-7f, "Clamped below");
+            expectWithinAbsoluteError(FastMathUtils::exp2(1000.0f) / std::exp2(127.0f), 1.0f, 1.7e-7f, "Clamped above");
+            logTimings("exp2", fast, [](float x) { return std::exp2(x); }, -24.0f, 24.0f);
+        }
+
+        beginTest("log2");
+        {
+            const auto fast = [](float x) { return FastMathUtils::log2(x); };
+            const auto reference = [](double x) { return std::log2(x); };
+            expectMaxError("log2, [0.5, 2]", fast, reference, 0.5, 2.0, Error::Absolute, 4.8e-7);
+            expectMaxError("log2, normal floats below 0.5", fast, reference, std::numeric_limits<float>::min(), 0.5, Error::Relative, 5.2e-7, Spacing::Logarithmic);
+            expectMaxError("log2, above 2", fast, reference, 2.0, std::numeric_limits<float>::max(), Error::Relative, 5.2e-7, Spacing::Logarithmic);
+            logTimings("log2", fast, [](float x) { return std::log2(x); }, 1.0e-5f, 16.0f);
+        }
+
+        beginTest("pow");
+        {
+            // Every pair with |y * log2(x)| under 16
+            auto maxError = 0.0;
+            for (auto i = 0; i <= numPoints / 1000; ++i)
+            {
+                const auto x = static_cast<float>(std::exp2(-16.0 + 32.0 * i / (numPoints / 1000)));
+                for (auto j = 0; j <= 1000; ++j)
+                {
+                    const auto y = static_cast<float>(-16.0 + 32.0 * j / 1000);
+                    const auto exponent = y * std::log2(static_cast<double>(x));
+                    if (std::abs(exponent) >= 16.0)
+                        continue;
+
+                    const auto expected = std::pow(static_cast<double>(x), static_cast<double>(y));
+                    maxError = std::max(maxError, std::abs((FastMathUtils::pow(x, y) - expected) / expected));
+                }
+            }
+
+            logMessage("pow max relative error " + juce::String(maxError));
+            expectLessThan(maxError, 6.5e-6, "pow");
+            expectEquals(FastMathUtils::pow(0.0f, 2.0f), 0.0f);
+            expectEquals(FastMathUtils::pow(-2.0f, 2.0f), 0.0f);
+            logTimings("pow", [](float x) { return FastMathUtils::pow(x, 1.5f); }, [](float x) { return std::pow(x, 1.5f); }, 1.0e-3f, 16.0f);
+        }
+
+        beginTest("semitonesToRatio");
+        {
+            const auto fast = [](float semitones) { return FastMathUtils::semitonesToRatio(semitones); };
+            expectMaxError("semitonesToRatio, +-48 semitones", fast, [](double semitones) { return std::exp2(semitones / 12.0); }, -48.0, 48.0, Error::Relative, 2.7e-7);
+            logTimings("semitonesToRatio", fast, [](float semitones) { return std::pow(2.0f, semitones / 12.0f); }, -48.0f, 48.0f);
+        }
+
+        beginTest("decibelsToGain");
+        {
+            const auto fast = [](float dB) { return FastMathUtils::decibelsToGain(dB); };
+            expectMaxError("decibelsToGain, [-120, 24]dB", fast, [](double dB) { return std::pow(10.0, dB / 20.0); }, -120.0, 24.0, Error::Relative, 8.5e-7);
+            logTimings("decibelsToGain", fast, [](float dB) { return juce::Decibels::decibelsToGain(dB); }, -120.0f, 24.0f);
+        }
+
+        beginTest("gainToDecibels");
+        {
+            constexpr auto minDb = -100.0f;
+            const auto fast = [](float gain) { return FastMathUtils::gainToDecibels(gain, minDb); };
+            expectMaxError("gainToDecibels", fast, [](double gain) { return 20.0 * std::log10(gain); }, 1.0e-5 * 1.0001, 16.0, Error::Absolute, 1.3e-5, Spacing::Logarithmic);
+            expectEquals(FastMathUtils::gainToDecibels(1.0e-5f, minDb), minDb);
+            expectEquals(FastMathUtils::gainToDecibels(0.0f, minDb), minDb);
+            logTimings("gainToDecibels", fast, [](float gain) { return juce::Decibels::gainToDecibels(gain, minDb); }, 1.0e-5f, 16.0f);
+        }
+    }
+
+private:
+    enum class Error { Absolute, Relative };
+    enum class Spacing { Linear, Logarithmic };
+
+    static constexpr int numPoints = 1 << 21;
+    static constexpr int numTimingSamples = 1 << 16;
+    static constexpr int numTimingRuns = 16;
+
+    template <typename Fast, typename Reference>
+    void expectMaxError(const juce::String& name, Fast fast, Reference reference, double start, double end, Error error, double bound, Spacing spacing = Spacing::Linear)
+    {
+        auto maxError = 0.0;
+        auto worstInput = 0.0f;
+        for (auto i = 0; i <= numPoints; ++i)
+        {
+            const auto proportion = static_cast<double>(i) / numPoints;
+            const auto x = static_cast<float>(spacing == Spacing::Linear ? start + (end - start) * proportion
+                                                                         : start * std::pow(end / start, proportion));
+
+            // The reference is taken at the float input, so only the approximation is measured
+            const auto expected = reference(static_cast<double>(x));
+            auto difference = std::abs(static_cast<double>(fast(x)) - expected);
+            if (error == Error::Relative)
+            {
+                difference /= std::abs(expected);
+            }
+
+            if (difference > maxError)
+            {
+                maxError = difference;
+                worstInput = x;
+            }
+        }
+
+        logMessage(name + (error == Error::Relative ? " max relative error " : " max abs error ") + juce::String(maxError) + " at " + juce::String(worstInput));
+        expectLessThan(maxError, bound, name);
+    }
+
+    template <typename Fast, typename Standard>
+    void logTimings(const juce::String& name, Fast fast, Standard standard, float start, float end)
+    {
+        std::vector<float> input(static_cast<size_t>(numTimingSamples));
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            input[i] = start + (end - start) * static_cast<float>(i) / static_cast<float>(input.size());
+        }
+
+        const auto fastSeconds = timeFunction(fast, input);
+        const auto standardSeconds = timeFunction(standard, input);
+        logMessage(name + ": std " + juce::String(standardSeconds * 1.0e9 / numTimingSamples, 2) + " ns, fast "
+                   + juce::String(fastSeconds * 1.0e9 / numTimingSamples, 2) + " ns per value ("
+                   + juce::String(standardSeconds / std::max(fastSeconds, 1.0e-12), 1) + "x)");
+    }
+
+    // Best of several runs over a buffer, the way the audio code calls these
+    template <typename Function>
+    static double timeFunction(Function function, const std::vector<float>& input)
+    {
+        std::vector<float> output(input.size());
+        auto bestSeconds = std::numeric_limits<double>::max();
+        for (auto run = 0; run < numTimingRuns; ++run)
+        {
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                output[i] = function(input[i]);
+            }
+
+            bestSeconds = std::min(bestSeconds, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks));
+        }
+
+        // Keeps the loop from being optimised away
+        volatile auto sink = output[output.size() / 2];
+        juce::ignoreUnused(sink);
+        return bestSeconds;
+    }
+};
+
+static FastMathTests fastMathTests;
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 26 Oct 2026 9:14:22am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../Source/Session/SessionReplayer.h"
+#include "RenderScenarios.h"
+
+namespace
+{
+    void applyCommonOptions(const juce::ArgumentList& args)
+    {
+        if (args.containsOption("--references"))
+        {
+            RenderScenarios::setReferenceFolder(args.getFileForOption("--references"));
+        }
+
+        if (args.containsOption("--tolerance"))
+        {
+            auto tolerance = RenderScenarios::getTolerance();
+            if (!RenderScenarios::parseTolerance(args.getValueForOption("--tolerance"), tolerance))
+                juce::ConsoleApplication::fail("Tolerance must be exact, abs:<error> or spectral:<dB>");
+
+            RenderScenarios::setTolerance(tolerance);
+        }
+    }
+
+    // [test] [--category <name>] [--seed <n>] [--references <folder>] [--tolerance <mode>]
+    void runTests(const juce::ArgumentList& args)
+    {
+        applyCommonOptions(args);
+
+        juce::UnitTestRunner runner;
+        runner.setAssertOnFailure(false);
+        const auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue() : 0;
+        if (args.containsOption("--category"))
+        {
+            runner.runTestsInCategory(args.getValueForOption("--category"), seed);
+        }
+        else
+        {
+            runner.runAllTests(seed);
+        }
+
+        auto failures = 0;
+        for (auto i = 0; i < runner.getNumResults(); ++i)
+        {
+            failures += runner.getResult(i)->failures;
+        }
+
+        if (failures > 0)
+            juce::ConsoleApplication::fail(juce::String(failures) + " test(s) failed");
+    }
+
+    // record-references [--references <folder>]
+    void recordReferences(const juce::ArgumentList& args)
+    {
+        applyCommonOptions(args);
+
+        const auto folder = RenderScenarios::getReferenceFolder();
+        if (folder.createDirectory().failed())
+            juce::ConsoleApplication::fail("Couldn't create " + folder.getFullPathName());
+
+        for (const auto& scenario : RenderScenarios::getCatalogue())
+        {
+            const auto file = RenderScenarios::getReferenceFile(scenario);
+            if (!RenderComparison::writeRender(file, RenderScenarios::render(scenario), RenderScenarios::sampleRate))
+                juce::ConsoleApplication::fail("Couldn't write " + file.getFullPathName());
+
+            std::cout << file.getFullPathName() << std::endl;
+        }
+    }
+
+    // replay <session log> [--csv <report file>] [--output <wav>] [--reference <wav>] [--tolerance <mode>]
+    void replaySession(const juce::ArgumentList& args)
+    {
+        args.checkMinNumArguments(2);
+        applyCommonOptions(args);
+        const auto logFile = args[1].resolveAsExistingFile();
+
+        SessionReplayer replayer;
+        if (!replayer.loadFromFile(logFile))
+            juce::ConsoleApplication::fail("Not a session log: " + logFile.getFullPathName());
+
+        juce::AudioBuffer<float> rendered;
+        const auto report = replayer.replay(&rendered);
+        std::cout << "Blocks:          " << report.blocks.size() << std::endl
+                  << "Sample rate:     " << report.sampleRate << std::endl
+                  << "Total render:    " << report.getTotalSeconds() * 1000.0 << " ms" << std::endl
+                  << "Worst block:     " << report.getWorstBlockSeconds() * 1000.0 << " ms" << std::endl
+                  << "Worst deadline:  " << report.getWorstDeadlineRatio() * 100.0 << " %" << std::endl
+                  << "Non-finite:      " << report.numNonFiniteSamples << std::endl
+                  << "Denormals:       " << report.numDenormalSamples << std::endl
+                  << "Inconsistent:    " << report.numInconsistentBlocks << std::endl;
+
+        if (args.containsOption("--csv"))
+        {
+            const auto reportFile = args.getFileForOption("--csv");
+            if (!report.writeToFile(reportFile))
+                juce::ConsoleApplication::fail("Couldn't write " + reportFile.getFullPathName());
+        }
+
+        if (args.containsOption("--output"))
+        {
+            const auto outputFile = args.getFileForOption("--output");
+            if (!RenderComparison::writeRender(outputFile, rendered, report.sampleRate))
+                juce::ConsoleApplication::fail("Couldn't write " + outputFile.getFullPathName());
+        }
+
+        if (report.numNonFiniteSamples > 0)
+            juce::ConsoleApplication::fail("The replay produced non-finite samples");
+
+        if (args.containsOption("--reference"))
+        {
+            juce::AudioBuffer<float> reference;
+            double referenceSampleRate = 0.0;
+            const auto referenceFile = args.getExistingFileForOption("--reference");
+            if (!RenderComparison::readRender(referenceFile, reference, referenceSampleRate))
+                juce::ConsoleApplication::fail("Couldn't read " + referenceFile.getFullPathName());
+
+            const auto result = RenderComparison::compare(rendered, reference, RenderScenarios::getTolerance());
+            std::cout << "Max abs error:   " << result.maxAbsError << std::endl
+                      << "First mismatch:  " << result.firstMismatchSample << std::endl;
+
+            if (!result.passed)
+                juce::ConsoleApplication::fail("The replay differs from the reference");
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "Usage:", true);
+    app.addDefaultCommand({ "test",
+                            "test [--category <name>] [--seed <n>] [--references <folder>] [--tolerance <mode>]",
+                            "Runs the unit, regression and stress tests, exits with 1 if any fail",
+                            "The tolerance for reference comparisons is exact, abs:<linear error> or spectral:<dB>, abs:0.0001 by default.",
+                            runTests });
+    app.addCommand({ "record-references",
+                     "record-references [--references <folder>]",
+                     "Renders the regression scenarios and stores them as the new references",
+                     "Only re-record after a change that is meant to alter the sound.",
+                     recordReferences });
+    app.addCommand({ "replay",
+                     "replay <session log> [--csv <report file>] [--output <wav>] [--reference <wav>] [--tolerance <mode>]",
+                     "Replays a captured session through a fresh engine and reports the per-block render time",
+                     "Sessions are captured by the plugin while the SYNTH_SESSION_CAPTURE environment variable names a log file. "
+                     "The replay is deterministic, so the timings compare builds on the same machine.",
+                     replaySession });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    MidiStormTests.cpp
+    Created: 26 Oct 2026 1:12:50pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/Session/MidiStormGenerator.h"
+#include "../Source/Session/SessionReplayer.h"
+
+// Replays generated MIDI storms (note floods, same-key re-strikes, velocity-0 note-ons,
+// pitch-wheel floods, pedals and play-mode changes) and fails on NaN/Inf or denormal
+// output or broken note bookkeeping. The worst block time is logged against the host's
+// callback period rather than checked, it's only meaningful in a Release build.
+// Every storm has a fixed seed so a failure can be replayed.
+class MidiStormTests : public juce::UnitTest
+{
+public:
+    MidiStormTests() : juce::UnitTest("MIDI storm", "Stress") {}
+
+    void runTest() override
+    {
+        MidiStormGenerator::Settings settings;
+
+        beginTest("Random block sizes");
+        runStorm(settings);
+
+        beginTest("Fixed block size");
+        settings.seed = 2;
+        settings.randomiseBlockSizes = false;
+        runStorm(settings);
+
+        beginTest("Small blocks, frequent play mode changes");
+        settings.seed = 3;
+        settings.maxBlockSize = 64;
+        settings.randomiseBlockSizes = true;
+        settings.playModeChangeProbability = 0.1f;
+        runStorm(settings);
+
+        beginTest("Every channel, multi-timbral");
+        settings.seed = 4;
+        settings.playModeChangeProbability = 0.01f;
+        settings.numChannels = 16;
+        runStorm(settings);
+
+        beginTest("Default settings, another seed");
+        settings = {};
+        settings.seed = 5;
+        runStorm(settings);
+    }
+
+private:
+    void runStorm(const MidiStormGenerator::Settings& settings)
+    {
+        logMessage("Seed " + juce::String(settings.seed));
+        juce::TemporaryFile logFile(".slog");
+        expect(MidiStormGenerator::writeLog(logFile.getFile(), settings));
+
+        SessionReplayer replayer;
+        expect(replayer.loadFromFile(logFile.getFile()));
+
+        const auto report = replayer.replay();
+        expectEquals(report.numNonFiniteSamples, 0, "NaN/Inf in the output");
+        expectEquals(report.numDenormalSamples, 0, "Denormals in the output");
+        expectEquals(report.numInconsistentBlocks, 0, "Note bookkeeping out of step");
+
+        // A host calls back once per prepared block, so no block should take longer than that
+        const auto callbackSeconds = settings.maxBlockSize / settings.sampleRate;
+        const auto worstSeconds = report.getWorstBlockSeconds();
+        logMessage("Worst block " + juce::String(worstSeconds * 1000.0, 3) + " ms of " + juce::String(callbackSeconds * 1000.0, 3) + " ms"
+                   + (worstSeconds < callbackSeconds ? "" : ", missed the callback deadline"));
+    }
+};
+
+static MidiStormTests midiStormTests;
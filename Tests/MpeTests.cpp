@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    MpeTests.cpp
+    Created: 26 Oct 2026 8:31:26pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "EngineTestFixture.h"
+
+// Per-channel note tracking and expression defaults with MPE enabled.
+class MpeTests : public EngineTestFixture
+{
+public:
+    MpeTests() : EngineTestFixture("MPE") {}
+
+    void runTest() override
+    {
+        beginTest("The same note on two member channels takes two voices");
+        {
+            SynthEngine engine;
+            prepare(engine, true);
+            play(engine, { juce::MidiMessage::noteOn(2, 60, velocity), juce::MidiMessage::noteOn(3, 60, velocity) });
+            expectEquals(engine.getNumActiveVoices(), 2);
+
+            play(engine, { juce::MidiMessage::noteOff(2, 60) });
+            expectEquals(engine.getNumActiveVoices(), 1, "A note-off on one channel released the other channel's note");
+
+            play(engine, { juce::MidiMessage::noteOff(3, 60) });
+            expectEquals(engine.getNumActiveVoices(), 0);
+            expect(engine.isNoteBookkeepingConsistent());
+        }
+
+        beginTest("A note without pressure plays at the non-MPE level");
+        {
+            SynthEngine mpeEngine, plainEngine;
+            prepare(mpeEngine, true);
+            prepare(plainEngine, false);
+            const auto mpeLevel = play(mpeEngine, { juce::MidiMessage::noteOn(2, 60, velocity) });
+            const auto plainLevel = play(plainEngine, { juce::MidiMessage::noteOn(1, 60, velocity) });
+            expectWithinAbsoluteError(juce::Decibels::gainToDecibels(mpeLevel / plainLevel), 0.0f, 0.1f);
+        }
+
+        beginTest("Zones follow the MPE configuration message");
+        {
+            SynthEngine engine;
+            prepare(engine, true);
+
+            // An upper zone over 15 channels makes channel 1 a member, so its pressure now reaches its note
+            play(engine, juce::MidiRPNGenerator::generate(16, 6, 15, false, false));
+            const auto levelBefore = play(engine, { juce::MidiMessage::noteOn(1, 60, velocity) });
+            const auto levelAfter = play(engine, { juce::MidiMessage::channelPressureChange(1, 0) });
+            expectLessThan(levelAfter, levelBefore * 0.75f, "Channel 1 pressure was ignored after the zone change");
+            expect(engine.isNoteBookkeepingConsistent());
+        }
+    }
+
+private:
+    static void prepare(SynthEngine& engine, bool mpeEnabled)
+    {
+        EngineTestFixture::prepare(engine);
+        engine.setMpeEnabled(mpeEnabled);
+    }
+};
+
+static MpeTests mpeTests;
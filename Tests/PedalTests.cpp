@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    PedalTests.cpp
+    Created: 26 Oct 2026 6:52:13pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "EngineTestFixture.h"
+
+// Repeated strikes of one key under a held pedal, which used to park the key once per
+// release until the list of deferred releases overflowed.
+class PedalTests : public EngineTestFixture
+{
+public:
+    PedalTests() : EngineTestFixture("Pedals") {}
+
+    void runTest() override
+    {
+        for (const auto mode : { EngineUtils::PlayMode::Polyphonic, EngineUtils::PlayMode::Monophonic })
+        {
+            const auto isPolyphonic = mode == EngineUtils::PlayMode::Polyphonic;
+            beginTest(juce::String("Re-striking a key under the sustain pedal, ") + (isPolyphonic ? "poly" : "mono"));
+
+            SynthEngine engine;
+            prepare(engine);
+            engine.setPlayMode(mode);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midiMessages;
+            midiMessages.addEvent(juce::MidiMessage::controllerEvent(1, 64, 127), 0);
+
+            // Several times the number of keys, all in one block and spread over many
+            for (auto i = 0; i < 4 * 128; ++i)
+            {
+                midiMessages.addEvent(juce::MidiMessage::noteOn(1, 60, velocity), 0);
+                midiMessages.addEvent(juce::MidiMessage::noteOff(1, 60), 0);
+                if (i % 8 == 0)
+                {
+                    engine.processBlock(buffer, midiMessages);
+                    midiMessages.clear();
+                    expect(engine.isNoteBookkeepingConsistent());
+                }
+            }
+
+            engine.processBlock(buffer, midiMessages);
+            midiMessages.clear();
+            expect(engine.isNoteBookkeepingConsistent());
+            expect(!engine.isSilent(), "The pedal didn't hold the key");
+
+            play(engine, { juce::MidiMessage::controllerEvent(1, 64, 0) });
+            expect(engine.isSilent(), "The key kept sounding after the pedal came up");
+            expect(engine.isNoteBookkeepingConsistent());
+        }
+    }
+};
+
+static PedalTests pedalTests;
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    PlayModeTests.cpp
+    Created: 26 Oct 2026 6:08:41pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "EngineTestFixture.h"
+
+// Switches play mode while keys are held and checks the held keys keep sounding until
+// their own note-offs, rather than being cut by the release of some other key.
+class PlayModeTests : public EngineTestFixture
+{
+public:
+    PlayModeTests() : EngineTestFixture("Play mode changes") {}
+
+    void runTest() override
+    {
+        beginTest("Poly to mono keeps the mono voice's key until it is released");
+        {
+            SynthEngine engine;
+            prepare(engine);
+            play(engine, { juce::MidiMessage::noteOn(1, 60, velocity), juce::MidiMessage::noteOn(1, 64, velocity) });
+
+            engine.setPlayMode(EngineUtils::PlayMode::Monophonic);
+            expect(engine.isNoteBookkeepingConsistent());
+
+            // Key 64 lost its voice in the switch, letting go of it must not end key 60
+            play(engine, { juce::MidiMessage::noteOff(1, 64) });
+            expect(isSounding(engine), "Releasing a key without a voice stopped the mono voice");
+
+            play(engine, { juce::MidiMessage::noteOff(1, 60) });
+            expect(!isSounding(engine), "The mono voice kept sounding after its key was released");
+            expect(engine.isNoteBookkeepingConsistent());
+        }
+
+        beginTest("Poly to mono hands over to a key still held");
+        {
+            SynthEngine engine;
+            prepare(engine);
+            play(engine, { juce::MidiMessage::noteOn(1, 60, velocity), juce::MidiMessage::noteOn(1, 64, velocity) });
+
+            engine.setPlayMode(EngineUtils::PlayMode::Monophonic);
+            play(engine, { juce::MidiMessage::noteOff(1, 60) });
+            expect(isSounding(engine), "The mono voice didn't move to the key still held");
+
+            play(engine, { juce::MidiMessage::noteOff(1, 64) });
+            expect(!isSounding(engine));
+        }
+
+        beginTest("Poly to duo keeps both voices");
+        {
+            SynthEngine engine;
+            prepare(engine);
+            play(engine, { juce::MidiMessage::noteOn(1, 60, velocity), juce::MidiMessage::noteOn(1, 64, velocity), juce::MidiMessage::noteOn(1, 67, velocity) });
+
+            engine.setPlayMode(EngineUtils::PlayMode::Duophonic);
+            play(engine, { juce::MidiMessage::noteOff(1, 67) });
+            expectEquals(engine.getNumActiveVoices(), 2);
+
+            play(engine, { juce::MidiMessage::noteOff(1, 60), juce::MidiMessage::noteOff(1, 64) });
+            expect(!isSounding(engine));
+            expect(engine.isNoteBookkeepingConsistent());
+        }
+    }
+
+private:
+    static bool isSounding(const SynthEngine& engine)
+    {
+        return engine.getNumActiveVoices() > 0 && !engine.isSilent();
+    }
+};
+
+static PlayModeTests playModeTests;
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    PluginProcessorTests.cpp
+    Created: 28 Oct 2026 10:22:37am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/PluginProcessor/PluginProcessor.h"
+#include "../Source/Constants/ParameterIds.h"
+
+// The plugin as a host drives it, for settings that only live in the parameters and
+// would be missed by the engine tests.
+class PluginProcessorTests : public juce::UnitTest
+{
+public:
+    PluginProcessorTests() : juce::UnitTest("Plugin processor", "Processor") {}
+
+    void runTest() override
+    {
+        beginTest("A fresh instance bounces at the default offline oversampling");
+        {
+            PluginProcessor processor;
+            processor.setNonRealtime(true);
+            processor.prepareToPlay(sampleRate, blockSize);
+            render(processor);
+            expectEquals(processor.getSynthEngine().getOversamplingFactor(), 4);
+
+            processor.setNonRealtime(false);
+            render(processor);
+            expectEquals(processor.getSynthEngine().getOversamplingFactor(), 1);
+        }
+
+        beginTest("Saved state restores the parameters and the engine");
+        {
+            juce::MemoryBlock state;
+            {
+                PluginProcessor processor;
+                setParameter(processor, ParameterIds::MasterGainId, 0.3f);
+                setParameter(processor, ParameterIds::OfflineOversamplingId, 1.0f);
+                processor.getStateInformation(state);
+            }
+
+            PluginProcessor processor;
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+            auto& parameters = processor.getAudioProcessorValueTreeState();
+            expectWithinAbsoluteError(parameters.getRawParameterValue(ParameterIds::MasterGainId)->load(), 0.3f, 0.001f);
+            expectWithinAbsoluteError(processor.getSynthEngine().getMasterGain(), 0.3f, 0.001f);
+
+            processor.setNonRealtime(true);
+            processor.prepareToPlay(sampleRate, blockSize);
+            render(processor);
+            expectEquals(processor.getSynthEngine().getOversamplingFactor(), 2);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    static void setParameter(PluginProcessor& processor, const char* parameterID, float value)
+    {
+        auto* parameter = processor.getAudioProcessorValueTreeState().getParameter(parameterID);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // A few blocks with a note held, so the part renders rather than idles
+    static void render(PluginProcessor& processor)
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+        midiMessages.addEvent(juce::MidiMessage::noteOn(1, 60, static_cast<juce::uint8>(100)), 0);
+        for (auto i = 0; i < 4; ++i)
+        {
+            processor.processBlock(buffer, midiMessages);
+            midiMessages.clear();
+        }
+
+        midiMessages.addEvent(juce::MidiMessage::noteOff(1, 60), 0);
+        processor.processBlock(buffer, midiMessages);
+    }
+};
+
+static PluginProcessorTests pluginProcessorTests;
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    ReleaseTailTests.cpp
+    Created: 26 Oct 2026 3:24:18pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/Engine/SynthEngine.h"
+#include "../Source/Gain/Gain.h"
+
+// Release tails decay towards the denormal range, where x86 CPUs can run arithmetic a
+// hundred times slower. The engine flushes denormals to zero, ends voices once they fall
+// below -80dB and lands fades on exact zero; these tests time a tail before and after that
+// guard and log the engine's block time all the way down to silence. Timings are only
+// meaningful in a Release build, so they're logged rather than checked.
+class ReleaseTailTests : public juce::UnitTest
+{
+public:
+    ReleaseTailTests() : juce::UnitTest("Release tail", "Benchmark") {}
+
+    void runTest() override
+    {
+        beginTest("Fade to silence ends on exact zero");
+        {
+            Gain gain;
+            gain.reset(1.0f);
+            gain.setTargetGain(0.0f, 0.05f, sampleRate);
+
+            auto sample = 1.0f;
+            for (auto i = 0; i < static_cast<int>(sampleRate); ++i)
+            {
+                sample = gain.processSample(1.0f);
+            }
+
+            expectEquals(sample, 0.0f);
+            expectEquals(gain.getCurrentGain(), 0.0f);
+        }
+
+        beginTest("Decaying feedback, denormals allowed vs flushed");
+        {
+            const auto denormalSeconds = timeDecayingFeedback(false);
+            const auto flushedSeconds = timeDecayingFeedback(true);
+            logMessage("Before " + juce::String(denormalSeconds * 1000.0, 3) + " ms, after " + juce::String(flushedSeconds * 1000.0, 3)
+                       + " ms (" + juce::String(denormalSeconds / std::max(flushedSeconds, 1.0e-9), 1) + "x)");
+        }
+
+        beginTest("Engine block time stays flat through a long release");
+        {
+            const auto [sustainSeconds, tailSeconds, silentAfter] = timeEngineRelease();
+            logMessage("Sustain " + juce::String(sustainSeconds * 1.0e6, 1) + " us/block, quiet tail " + juce::String(tailSeconds * 1.0e6, 1)
+                       + " us/block (" + juce::String(tailSeconds / std::max(sustainSeconds, 1.0e-9), 2) + "x), silent after " + juce::String(silentAfter, 2) + " s");
+            expect(silentAfter > 0.0, "Voices never finished their release");
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+    static constexpr int numTailSamples = 1 << 18;
+    static constexpr int numRuns = 8;
+    static constexpr float sustainSeconds = 1.0f;
+    static constexpr float releaseSeconds = 6.0f;
+
+    // A one-pole feedback path, the kind a filter or reverb runs on a dying tail, started
+    // just above the denormal range so nearly every step lands inside it without the guard
+    static double timeDecayingFeedback(bool flushDenormals)
+    {
+        juce::FloatVectorOperations::disableDenormalisedNumberSupport(flushDenormals);
+        std::vector<float> output(static_cast<size_t>(numTailSamples));
+
+        auto bestSeconds = std::numeric_limits<double>::max();
+        for (auto run = 0; run < numRuns; ++run)
+        {
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            auto state = 1.0e-37f;
+            for (auto& sample : output)
+            {
+                state *= 0.9999f;
+                sample = state;
+            }
+
+            bestSeconds = std::min(bestSeconds, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks));
+        }
+
+        juce::FloatVectorOperations::disableDenormalisedNumberSupport(false);
+
+        // Keeps the loop from being optimised away
+        volatile auto sink = output.back();
+        juce::ignoreUnused(sink);
+        return bestSeconds;
+    }
+
+    // Median block time while a full chord sustains, and over the last second of its
+    // release. Also reports when the engine went silent, in seconds after the note-offs
+    static std::tuple<double, double, double> timeEngineRelease()
+    {
+        SynthEngine engine;
+        engine.prepareToPlay(sampleRate, blockSize);
+        engine.setOscillatorAType(OscillatorUtils::WaveType::Saw);
+        engine.setOscillatorBType(OscillatorUtils::WaveType::Square);
+        engine.setOscillatorGains(1.0f, 0.5f, 0.0f);
+        engine.setAmplitudeEnvelopeParams({ 0.005f, 0.1f, 0.8f, releaseSeconds });
+        engine.setMasterGain(1.0f);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+        const int chord[] = { 48, 52, 55, 60, 64, 67, 71, 72 };
+        for (const auto note : chord)
+        {
+            midiMessages.addEvent(juce::MidiMessage::noteOn(1, note, static_cast<juce::uint8>(100)), 0);
+        }
+
+        const auto numSustainBlocks = static_cast<int>(sustainSeconds * sampleRate / blockSize);
+        const auto numReleaseBlocks = static_cast<int>((releaseSeconds + 1.0) * sampleRate / blockSize);
+        std::vector<double> sustainTimes, tailTimes;
+        auto silentAfter = -1.0;
+
+        for (auto block = 0; block < numSustainBlocks + numReleaseBlocks; ++block)
+        {
+            if (block == numSustainBlocks)
+            {
+                for (const auto note : chord)
+                {
+                    midiMessages.addEvent(juce::MidiMessage::noteOff(1, note), 0);
+                }
+            }
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            engine.processBlock(buffer, midiMessages);
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+            midiMessages.clear();
+
+            const auto releaseBlock = block - numSustainBlocks;
+            if (releaseBlock < 0)
+            {
+                sustainTimes.push_back(seconds);
+            }
+            else if (releaseBlock * blockSize >= (releaseSeconds - 1.0) * sampleRate && releaseBlock * blockSize < releaseSeconds * sampleRate)
+            {
+                tailTimes.push_back(seconds);
+            }
+
+            if (releaseBlock >= 0 && silentAfter < 0.0 && engine.isSilent())
+            {
+                silentAfter = releaseBlock * blockSize / sampleRate;
+            }
+        }
+
+        return { getMedian(sustainTimes), getMedian(tailTimes), silentAfter };
+    }
+
+    static double getMedian(std::vector<double> values)
+    {
+        if (values.empty())
+            return 0.0;
+
+        const auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+};
+
+static ReleaseTailTests releaseTailTests;
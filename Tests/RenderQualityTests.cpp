@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    RenderQualityTests.cpp
+    Created: 28 Oct 2026 2:47:15pm
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "EngineTestFixture.h"
+#include "../Source/Engine/RenderGovernor.h"
+
+// Changes the render quality under held notes, as a bounce or the load governor does,
+// and checks the notes carry on rather than being restarted at the new rate.
+class RenderQualityTests : public EngineTestFixture
+{
+public:
+    RenderQualityTests() : EngineTestFixture("Render quality changes") {}
+
+    void runTest() override
+    {
+        beginTest("A held note keeps its level across an oversampling change");
+        {
+            SynthEngine engine;
+            engine.setOversampling(EngineUtils::OversamplingFactor::Off, EngineUtils::OversamplingFactor::FourTimes);
+            prepare(engine);
+
+            const auto levelBefore = play(engine, { juce::MidiMessage::noteOn(1, 69, velocity) });
+
+            engine.setNonRealtime(true);
+            const auto levelAfter = play(engine, juce::MidiBuffer());
+            expectEquals(engine.getOversamplingFactor(), 4);
+            expectEquals(engine.getNumActiveVoices(), 1);
+            expectWithinAbsoluteError(juce::Decibels::gainToDecibels(levelAfter / levelBefore), 0.0f, 0.5f);
+        }
+
+        beginTest("Sustained overload renders cheaper");
+        {
+            // A block that takes longer than its deadline, until the governor reaches its top level
+            RenderGovernor governor;
+            governor.prepare(sampleRate);
+            const auto deadlineSeconds = blockSize / sampleRate;
+            for (auto i = 0; i < static_cast<int>(sampleRate / blockSize); ++i)
+            {
+                governor.update(deadlineSeconds * 1.5, blockSize);
+            }
+
+            expectEquals(governor.getLevel(), RenderGovernor::maxLevel);
+
+            SynthEngine engine;
+            engine.setOversampling(EngineUtils::OversamplingFactor::FourTimes, EngineUtils::OversamplingFactor::FourTimes);
+            prepare(engine);
+
+            juce::MidiBuffer midiMessages;
+            for (auto note : { 48, 55, 60, 64, 67, 72 })
+            {
+                midiMessages.addEvent(juce::MidiMessage::noteOn(1, note, velocity), 0);
+            }
+
+            play(engine, midiMessages);
+            const auto fullSeconds = timeBlocks(engine);
+            const auto fullQuality = engine.getRenderQuality().reducedBy(0);
+            expectEquals(engine.getOversamplingFactor(), 4);
+
+            engine.setLoadReduction(governor.getLevel());
+            play(engine, juce::MidiBuffer());
+            const auto governedSeconds = timeBlocks(engine);
+            const auto governedQuality = engine.getRenderQuality().reducedBy(governor.getLevel());
+            expectEquals(engine.getOversamplingFactor(), 1);
+            expectEquals(engine.getNumActiveVoices(), 6);
+
+            // A quarter of the voice samples, and modulation updated far less often
+            expectGreaterThan(governedQuality.controlBlockSize, fullQuality.controlBlockSize);
+            logMessage("Governed block time " + juce::String(governedSeconds / fullSeconds, 2) + " of full quality");
+        }
+    }
+
+private:
+    // Average block time over a second of audio. Only means something in a Release build
+    static double timeBlocks(SynthEngine& engine)
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midiMessages;
+        const auto numBlocks = static_cast<int>(sampleRate / blockSize);
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        for (auto i = 0; i < numBlocks; ++i)
+        {
+            engine.processBlock(buffer, midiMessages);
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) / numBlocks;
+    }
+};
+
+static RenderQualityTests renderQualityTests;
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    RenderRegressionTests.cpp
+    Created: 26 Oct 2026 10:41:09am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RenderScenarios.h"
+
+// Renders the scenario catalogue and compares each render against its stored reference.
+// References are recorded with "midiSynthTests record-references" and only re-recorded
+// when a change to the sound is intended. They aren't kept in the repository, so a
+// scenario without one is skipped and logged rather than failed.
+class RenderRegressionTests : public juce::UnitTest
+{
+public:
+    RenderRegressionTests() : juce::UnitTest("Render regression", "Regression") {}
+
+    void runTest() override
+    {
+        const auto tolerance = RenderScenarios::getTolerance();
+        for (const auto& scenario : RenderScenarios::getCatalogue())
+        {
+            beginTest(scenario.name);
+
+            juce::AudioBuffer<float> reference;
+            double referenceSampleRate = 0.0;
+            const auto referenceFile = RenderScenarios::getReferenceFile(scenario);
+            if (!RenderComparison::readRender(referenceFile, reference, referenceSampleRate))
+            {
+                logMessage("Skipped, no reference at " + referenceFile.getFullPathName() + ", run record-references on a known good build");
+                continue;
+            }
+
+            expectEquals(referenceSampleRate, RenderScenarios::sampleRate);
+
+            const auto result = RenderComparison::compare(RenderScenarios::render(scenario), reference, tolerance);
+            expect(result.lengthsMatch, "Render length differs from the reference");
+            expectEquals(result.numNonFiniteSamples, 0, "Non-finite samples");
+            expect(result.passed, "First mismatch at sample " + juce::String(result.firstMismatchSample)
+                                  + ", max abs error " + juce::String(result.maxAbsError)
+                                  + ", spectral distance " + juce::String(result.spectralDistanceDb) + " dB");
+        }
+    }
+};
+
+static RenderRegressionTests renderRegressionTests;
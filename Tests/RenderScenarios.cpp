@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    RenderScenarios.cpp
+    Created: 26 Oct 2026 10:02:37am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include "RenderScenarios.h"
+
+namespace
+{
+    struct ScriptEvent
+    {
+        double seconds;
+        juce::MidiMessage message;
+    };
+
+    // Overlapping keys, so the mono and duo modes have to hand voices over, with a bend in the middle
+    std::vector<ScriptEvent> getScript()
+    {
+        return {
+            { 0.00, juce::MidiMessage::noteOn(1, 60, static_cast<juce::uint8>(100)) },
+            { 0.10, juce::MidiMessage::noteOn(1, 64, static_cast<juce::uint8>(90)) },
+            { 0.20, juce::MidiMessage::noteOn(1, 67, static_cast<juce::uint8>(80)) },
+            { 0.40, juce::MidiMessage::pitchWheel(1, 12288) },
+            { 0.50, juce::MidiMessage::noteOff(1, 64) },
+            { 0.60, juce::MidiMessage::pitchWheel(1, 8192) },
+            { 0.70, juce::MidiMessage::noteOn(1, 72, static_cast<juce::uint8>(110)) },
+            { 0.80, juce::MidiMessage::noteOff(1, 60) },
+            { 0.80, juce::MidiMessage::noteOff(1, 67) },
+            { 1.00, juce::MidiMessage::noteOff(1, 72) }
+        };
+    }
+
+    struct EnvelopePreset
+    {
+        const char* name;
+        juce::ADSR::Parameters parameters;
+    };
+
+    const EnvelopePreset envelopePresets[] = {
+        { "pluck", { 0.002f, 0.3f, 0.0f, 0.2f } },
+        { "pad", { 0.4f, 0.5f, 0.7f, 0.5f } },
+        { "organ", { 0.005f, 0.0f, 1.0f, 0.05f } }
+    };
+
+    juce::File referenceFolder;
+    RenderComparison::Tolerance tolerance { RenderComparison::Mode::MaxAbsError, 1.0e-4f, 0.5f };
+
+    // The project folder is the first one above the executable holding the test project
+    juce::File findDefaultReferenceFolder()
+    {
+        auto folder = juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory();
+        while (!folder.isRoot())
+        {
+            if (folder.getChildFile("midiSynthTests.jucer").existsAsFile())
+                return folder.getChildFile("Tests").getChildFile("References");
+
+            folder = folder.getParentDirectory();
+        }
+
+        return juce::File::getCurrentWorkingDirectory().getChildFile("Tests").getChildFile("References");
+    }
+}
+
+std::vector<RenderScenarios::Scenario> RenderScenarios::getCatalogue()
+{
+    using WaveType = OscillatorUtils::WaveType;
+    using PlayMode = EngineUtils::PlayMode;
+
+    const std::pair<WaveType, const char*> waveTypes[] = {
+        { WaveType::Sine, "sine" },
+        { WaveType::Triangle, "triangle" },
+        { WaveType::Square, "square" },
+        { WaveType::Saw, "saw" }
+    };
+
+    const std::pair<PlayMode, const char*> playModes[] = {
+        { PlayMode::Monophonic, "mono" },
+        { PlayMode::Duophonic, "duo" },
+        { PlayMode::Polyphonic, "poly" }
+    };
+
+    std::vector<Scenario> catalogue;
+    for (const auto& [waveType, waveName] : waveTypes)
+    {
+        for (const auto& [playMode, modeName] : playModes)
+        {
+            for (const auto& preset : envelopePresets)
+            {
+                catalogue.push_back({ juce::String(waveName) + "_" + modeName + "_" + preset.name, waveType, playMode, preset.parameters });
+            }
+        }
+    }
+
+    return catalogue;
+}
+
+juce::AudioBuffer<float> RenderScenarios::render(const Scenario& scenario)
+{
+    SynthEngine engine;
+    engine.prepareToPlay(sampleRate, blockSize);
+    engine.setPlayMode(scenario.playMode);
+    engine.setOscillatorAType(scenario.waveType);
+    engine.setOscillatorBType(scenario.waveType);
+    engine.setOscillatorGains(1.0f, 0.5f, 0.0f);
+    engine.setAmplitudeEnvelopeParams(scenario.envelope);
+    engine.setMasterGain(1.0f);
+
+    const auto numSamples = static_cast<int>(lengthSeconds * sampleRate);
+    juce::AudioBuffer<float> output(2, numSamples);
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer midiBuffer;
+
+    const auto script = getScript();
+    size_t nextEvent = 0;
+    for (auto start = 0; start < numSamples; start += blockSize)
+    {
+        const auto length = std::min(blockSize, numSamples - start);
+        midiBuffer.clear();
+        while (nextEvent < script.size())
+        {
+            const auto position = static_cast<int>(script[nextEvent].seconds * sampleRate) - start;
+            if (position >= length)
+                break;
+
+            midiBuffer.addEvent(script[nextEvent].message, std::max(0, position));
+            ++nextEvent;
+        }
+
+        juce::AudioBuffer<float> subBlock(block.getArrayOfWritePointers(), 2, length);
+        engine.processBlock(subBlock, midiBuffer);
+        for (auto channel = 0; channel < 2; ++channel)
+        {
+            output.copyFrom(channel, start, subBlock, channel, 0, length);
+        }
+    }
+
+    return output;
+}
+
+void RenderScenarios::setReferenceFolder(const juce::File& folder)
+{
+    referenceFolder = folder;
+}
+
+juce::File RenderScenarios::getReferenceFolder()
+{
+    return referenceFolder == juce::File() ? findDefaultReferenceFolder() : referenceFolder;
+}
+
+juce::File RenderScenarios::getReferenceFile(const Scenario& scenario)
+{
+    return getReferenceFolder().getChildFile(scenario.name + ".wav");
+}
+
+void RenderScenarios::setTolerance(const RenderComparison::Tolerance& newTolerance)
+{
+    tolerance = newTolerance;
+}
+
+RenderComparison::Tolerance RenderScenarios::getTolerance()
+{
+    return tolerance;
+}
+
+// "exact", "abs:<linear error>" or "spectral:<dB>"
+bool RenderScenarios::parseTolerance(const juce::String& text, RenderComparison::Tolerance& result)
+{
+    const auto mode = text.upToFirstOccurrenceOf(":", false, false).trim().toLowerCase();
+    const auto value = text.fromFirstOccurrenceOf(":", false, false).trim();
+
+    if (mode == "exact")
+    {
+        result.mode = RenderComparison::Mode::BitExact;
+        return true;
+    }
+
+    if (value.isEmpty() || value.getFloatValue() < 0.0f)
+        return false;
+
+    if (mode == "abs")
+    {
+        result.mode = RenderComparison::Mode::MaxAbsError;
+        result.maxAbsError = value.getFloatValue();
+        return true;
+    }
+
+    if (mode == "spectral")
+    {
+        result.mode = RenderComparison::Mode::SpectralDistance;
+        result.maxSpectralDistanceDb = value.getFloatValue();
+        return true;
+    }
+
+    return false;
+}
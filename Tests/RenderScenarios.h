@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    RenderScenarios.h
+    Created: 26 Oct 2026 10:02:37am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../Source/Engine/SynthEngine.h"
+#include "../Source/Session/RenderComparison.h"
+
+// The fixed catalogue of MIDI scenarios the golden-output regression test renders: every
+// analytic waveform in every play mode with every envelope preset. Each one is rendered
+// through a fresh SynthEngine and compared against its stored reference WAV.
+namespace RenderScenarios
+{
+    inline constexpr double sampleRate = 48000.0;
+    inline constexpr int blockSize = 256;
+    inline constexpr double lengthSeconds = 1.6;
+
+    struct Scenario
+    {
+        juce::String name; // Also the reference file name
+        OscillatorUtils::WaveType waveType = OscillatorUtils::WaveType::Sine;
+        EngineUtils::PlayMode playMode = EngineUtils::PlayMode::Polyphonic;
+        juce::ADSR::Parameters envelope;
+    };
+
+    std::vector<Scenario> getCatalogue();
+    juce::AudioBuffer<float> render(const Scenario& scenario);
+
+    // References live in Tests/References unless another folder is given on the command line
+    void setReferenceFolder(const juce::File& folder);
+    juce::File getReferenceFolder();
+    juce::File getReferenceFile(const Scenario& scenario);
+
+    // Defaults to a max-abs-error of -80dB, loose enough for reordered float maths
+    void setTolerance(const RenderComparison::Tolerance& tolerance);
+    RenderComparison::Tolerance getTolerance();
+    bool parseTolerance(const juce::String& text, RenderComparison::Tolerance& tolerance);
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    VoiceBudgetTests.cpp
+    Created: 27 Oct 2026 9:14:52am
+    Author:  Joshua Navon
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "EngineTestFixture.h"
+
+// Parts asking for more voices than the budget has left in the same block, which used to
+// go to the lowest channel first and leave the parts after it with nothing.
+class VoiceBudgetTests : public EngineTestFixture
+{
+public:
+    VoiceBudgetTests() : EngineTestFixture("Voice budget") {}
+
+    void runTest() override
+    {
+        beginTest("Parts asking for the same number of voices get the same share");
+        {
+            MultiTimbralEngine engine;
+            prepare(engine, 4);
+            playNotes(engine, { 1, 2 }, 4);
+            expectEquals(engine.getPart(0).getNumActiveVoices(), 2);
+            expectEquals(engine.getPart(1).getNumActiveVoices(), 2);
+            expect(engine.isNoteBookkeepingConsistent());
+        }
+
+        beginTest("A part alone gets the whole budget");
+        {
+            MultiTimbralEngine engine;
+            prepare(engine, 4);
+            playNotes(engine, { 2 }, 6);
+            expectEquals(engine.getPart(1).getNumActiveVoices(), 4);
+        }
+
+        beginTest("Voices left over from sharing go round the parts");
+        {
+            // Three voices between two parts leaves one over, and it goes to a different part each time
+            MultiTimbralEngine engine;
+            prepare(engine, 3);
+            auto numExtraVoices = std::array<int, 2> {};
+            for (auto round = 0; round < 2; ++round)
+            {
+                playNotes(engine, { 1, 2 }, 4);
+                const auto firstPartVoices = engine.getPart(0).getNumActiveVoices();
+                expectEquals(firstPartVoices + engine.getPart(1).getNumActiveVoices(), 3);
+                ++numExtraVoices[firstPartVoices == 2 ? 0 : 1];
+
+                playNotes(engine, { 1, 2 }, 4, false);
+                expectEquals(engine.getPart(0).getNumActiveVoices() + engine.getPart(1).getNumActiveVoices(), 0);
+            }
+
+            expectEquals(numExtraVoices[0], 1);
+            expectEquals(numExtraVoices[1], 1);
+        }
+    }
+
+private:
+    static void prepare(MultiTimbralEngine& engine, int voiceBudget)
+    {
+        EngineTestFixture::prepare(engine);
+        engine.setLoadReductionEnabled(false);
+        engine.setMultiTimbral(true);
+        engine.setVoiceBudget(voiceBudget);
+    }
+
+    // One block with numNotes note-ons on each of the channels, all at the start. Note-offs
+    // are followed by a quarter second so the releases have run out
+    static void playNotes(MultiTimbralEngine& engine, std::initializer_list<int> channels, int numNotes, bool isNoteOn = true)
+    {
+        juce::MidiBuffer midiMessages;
+        for (const auto channel : channels)
+        {
+            for (auto i = 0; i < numNotes; ++i)
+            {
+                midiMessages.addEvent(isNoteOn ? juce::MidiMessage::noteOn(channel, 60 + i, velocity)
+                                               : juce::MidiMessage::noteOff(channel, 60 + i), 0);
+            }
+        }
+
+        if (!isNoteOn)
+        {
+            play(engine, midiMessages);
+            return;
+        }
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        engine.processBlock(buffer, midiMessages);
+    }
+};
+
+static VoiceBudgetTests voiceBudgetTests;